@@ -30,17 +30,8 @@ end
 ---@return nil
 local function playerDeathSuccess(playerId, playerName, killerId, playerGuid, byPlayer, killerName, playerGuildId, killerGuildId,
                                   timeNow)
-	local resultId = db.storeQuery("SELECT `player_id` FROM `player_deaths` WHERE `player_id` = " .. playerGuid)
-	if not resultId then return end
-
-	local deathRecords = 0
-	local tmpResultId = true
-	while tmpResultId do
-		tmpResultId = result.next(resultId)
-		deathRecords = deathRecords + 1
-	end
-
-	result.free(resultId)
+	local rows = db.awaitStoreQuery("SELECT COUNT(*) AS `records` FROM `player_deaths` WHERE `player_id` = " .. playerGuid)
+	local deathRecords = rows and rows[1] and rows[1].records or 0
 
 	local limit = deathRecords - maxDeathRecords
 	if limit > 0 then
@@ -50,15 +41,11 @@ local function playerDeathSuccess(playerId, playerName, killerId, playerGuid, by
 	if byPlayer then
 		if playerGuildId ~= 0 then
 			if killerGuildId ~= 0 and playerGuildId ~= killerGuildId and isInWar(playerId, killerId) then
-				resultId = db.storeQuery(format(
-					                         "SELECT `id` FROM `guild_wars` WHERE `status` = 1 AND ((`guild1` = %d AND `guild2` = %d) OR (`guild1` = %d AND `guild2` = %d))",
-					                         killerGuildId, playerGuildId, playerGuildId, killerGuildId))
+				local wars = db.awaitStoreQuery(format(
+					                                "SELECT `id` FROM `guild_wars` WHERE `status` = 1 AND ((`guild1` = %d AND `guild2` = %d) OR (`guild1` = %d AND `guild2` = %d))",
+					                                killerGuildId, playerGuildId, playerGuildId, killerGuildId))
 
-				local warId = nil
-				if resultId then
-					warId = result.getNumber(resultId, "id")
-					result.free(resultId)
-				end
+				local warId = wars and wars[1] and wars[1].id
 
 				if warId then
 					db.asyncQuery(format(
@@ -91,7 +78,7 @@ function onDeath(player, corpse, killer, mostDamageKiller, lastHitUnjustified, m
 	                     db.escapeString(killerNameMostDamage), byPlayerMostDamage and 1 or 0, lastHitUnjustified and 1 or 0,
 	                     mostDamageUnjustified and 1 or 0), function(success)
 		if success then
-			playerDeathSuccess(playerId, playerName, killerId, playerGuid, byPlayer, killerName, playerGuildId, killerGuildId, timeNow)
+			db.async(playerDeathSuccess, playerId, playerName, killerId, playerGuid, byPlayer, killerName, playerGuildId, killerGuildId, timeNow)
 		end
 	end)
 end
@@ -7,6 +7,7 @@ dofile("data/lib/core/combat.lua")
 dofile("data/lib/core/constants.lua")
 dofile("data/lib/core/container.lua")
 dofile("data/lib/core/creature.lua")
+dofile("data/lib/core/database.lua")
 dofile("data/lib/core/game.lua")
 dofile("data/lib/core/item.lua")
 dofile("data/lib/core/itemtype.lua")
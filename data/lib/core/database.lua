@@ -0,0 +1,9 @@
+---Runs callback as a coroutine, so it can wait for db.awaitQuery and db.awaitStoreQuery
+---without holding up the game loop while the database answers. Both return false when the query fails.
+---@param callback function
+---@param ... any
+function db.async(callback, ...)
+	local co = coroutine.create(callback)
+	local ok, err = coroutine.resume(co, ...)
+	if not ok then error(debug.traceback(co, err), 0) end
+end
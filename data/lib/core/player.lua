@@ -101,8 +101,7 @@ function Player.transferMoneyTo(self, target, amount)
 	if targetPlayer then
 		targetPlayer:setBankBalance(targetPlayer:getBankBalance() + amount)
 	else
-		db.query("UPDATE `players` SET `balance` = `balance` + " .. amount .. " WHERE `id` = '" ..
-			         target.guid .. "'")
+		Game.increaseBankBalance(target.guid, amount)
 	end
 
 	self:setBankBalance(self:getBankBalance() - amount)
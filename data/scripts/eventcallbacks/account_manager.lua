@@ -457,19 +457,7 @@ end
 ---@param reason string
 ---@return boolean
 local function banIp(player, days, reason)
-	local ip = player:getIp()
-	local resultId = db.storeQuery("SELECT 1 FROM `ip_bans` WHERE `ip` = " .. ip)
-	if resultId then
-		result.free(resultId)
-		return false
-	end
-
-	local timeNow = os.time()
-	db.query(string.format(
-		         "INSERT INTO `ip_bans` (`ip`, `reason`, `banned_at`, `expires_at`, `banned_by`) VALUES (%d, %s, %d, %d, %d)",
-		         ip, db.escapeString(reason), timeNow, timeNow + (days * 86400),
-		         player:getGuid()))
-	return true
+	return Game.addIpBan(player:getIp(), reason, os.time() + (days * 86400), player)
 end
 
 local login = CreatureEvent("Account Manager Login")
@@ -13,19 +13,8 @@ function onSay(player, words, param)
 	local accountId = getAccountNumberByPlayerName(name)
 	if accountId == 0 then return false end
 
-	local resultId = db.storeQuery(
-		                 "SELECT 1 FROM `account_bans` WHERE `account_id` = " ..
-			                 accountId)
-	if resultId ~= false then
-		result.free(resultId)
-		return false
-	end
-
-	local timeNow = os.time()
-	db.query(
-		"INSERT INTO `account_bans` (`account_id`, `reason`, `banned_at`, `expires_at`, `banned_by`) VALUES (" ..
-			accountId .. ", " .. db.escapeString(reason) .. ", " .. timeNow .. ", " ..
-			timeNow + (banDays * 86400) .. ", " .. player:getGuid() .. ")")
+	if not Game.addAccountBan(accountId, reason, os.time() + (banDays * 86400),
+	                          player) then return false end
 
 	local target = Player(name)
 	if target then
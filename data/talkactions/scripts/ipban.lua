@@ -18,19 +18,12 @@ function onSay(player, words, param)
 
 	if targetIp == 0 then return false end
 
-	resultId = db.storeQuery("SELECT 1 FROM `ip_bans` WHERE `ip` = " .. targetIp)
-	if resultId ~= false then
+	if not Game.addIpBan(targetIp, "", os.time() + (ipBanDays * 86400), player) then
 		player:sendTextMessage(MESSAGE_EVENT_ADVANCE,
 		                       targetName .. "  is already IP banned.")
-		result.free(resultId)
 		return false
 	end
 
-	local timeNow = os.time()
-	db.query(
-		"INSERT INTO `ip_bans` (`ip`, `reason`, `banned_at`, `expires_at`, `banned_by`) VALUES (" ..
-			targetIp .. ", '', " .. timeNow .. ", " .. timeNow + (ipBanDays * 86400) ..
-			", " .. player:getGuid() .. ")")
 	player:sendTextMessage(MESSAGE_EVENT_ADVANCE,
 	                       targetName .. "  has been IP banned.")
 	return false
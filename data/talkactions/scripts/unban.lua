@@ -4,10 +4,8 @@ function onSay(player, words, param)
 			                 db.escapeString(param))
 	if resultId == false then return false end
 
-	db.asyncQuery("DELETE FROM `account_bans` WHERE `account_id` = " ..
-		              result.getNumber(resultId, "account_id"))
-	db.asyncQuery("DELETE FROM `ip_bans` WHERE `ip` = " ..
-		              result.getNumber(resultId, "lastip"))
+	Game.removeAccountBan(result.getNumber(resultId, "account_id"))
+	Game.removeIpBan(result.getNumber(resultId, "lastip"))
 	result.free(resultId)
 	player:sendTextMessage(MESSAGE_EVENT_ADVANCE, param .. " has been unbanned.")
 	return false
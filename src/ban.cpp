@@ -5,20 +5,115 @@
 
 #include "ban.h"
 
+#include "configmanager.h"
 #include "connection.h"
 #include "database.h"
 #include "databasetasks.h"
+#include "scheduler.h"
 #include "tools.h"
 
+#include <shared_mutex>
+
+extern Dispatcher g_dispatcher;
+extern Scheduler g_scheduler;
+
+namespace {
+
+struct BanEntry
+{
+	BanInfo info;
+	time_t bannedAt;
+	uint32_t bannedById;
+};
+
+struct BanTable
+{
+	std::unordered_map<uint32_t, BanEntry> accountBans;
+	std::unordered_map<uint32_t, BanEntry> ipBans;
+	std::unordered_set<uint32_t> namelocks;
+};
+
+BanTable banTable;
+std::shared_mutex banTableLock;
+// bumped by every write through, a reload that overlaps one is dropped rather than undoing it
+uint64_t banTableWrites = 0;
+
+bool loadBanTable(Database& db, BanTable& table)
+{
+	// expired bans are left to the startup script, which moves them to the history
+	const time_t now = time(nullptr);
+
+	// a failed query must not read as no bans at all
+	DBResult_ptr result;
+	std::string query = fmt::format(
+	    "SELECT `account_id`, `reason`, `expires_at`, `banned_at`, `banned_by`, (SELECT `name` FROM `players` WHERE `id` = `banned_by`) AS `name` FROM `account_bans` WHERE `expires_at` = 0 OR `expires_at` > {:d}",
+	    now);
+	if (!db.storeQuery(query, result)) {
+		return false;
+	}
+
+	if (result) {
+		do {
+			BanEntry& entry = table.accountBans[result->getNumber<uint32_t>("account_id")];
+			entry.info.expiresAt = result->getNumber<time_t>("expires_at");
+			entry.info.reason = result->getString("reason");
+			entry.info.bannedBy = result->getString("name");
+			entry.bannedAt = result->getNumber<time_t>("banned_at");
+			entry.bannedById = result->getNumber<uint32_t>("banned_by");
+		} while (result->next());
+	}
+
+	query = fmt::format(
+	    "SELECT `ip`, `reason`, `expires_at`, `banned_at`, `banned_by`, (SELECT `name` FROM `players` WHERE `id` = `banned_by`) AS `name` FROM `ip_bans` WHERE `expires_at` = 0 OR `expires_at` > {:d}",
+	    now);
+	if (!db.storeQuery(query, result)) {
+		return false;
+	}
+
+	if (result) {
+		do {
+			BanEntry& entry = table.ipBans[result->getNumber<uint32_t>("ip")];
+			entry.info.expiresAt = result->getNumber<time_t>("expires_at");
+			entry.info.reason = result->getString("reason");
+			entry.info.bannedBy = result->getString("name");
+			entry.bannedAt = result->getNumber<time_t>("banned_at");
+			entry.bannedById = result->getNumber<uint32_t>("banned_by");
+		} while (result->next());
+	}
+
+	if (!db.storeQuery("SELECT `player_id` FROM `player_namelocks`", result)) {
+		return false;
+	}
+
+	if (result) {
+		do {
+			table.namelocks.insert(result->getNumber<uint32_t>("player_id"));
+		} while (result->next());
+	}
+	return true;
+}
+
+bool isExpired(const BanEntry& entry) { return entry.info.expiresAt != 0 && time(nullptr) > entry.info.expiresAt; }
+
+} // namespace
+
 bool Ban::acceptConnection(const uint32_t clientIP)
 {
-	std::lock_guard<std::recursive_mutex> lockClass(lock);
+	Shard& shard = getShard(clientIP);
+	std::lock_guard<std::mutex> lockClass(shard.lock);
 
 	uint64_t currentTime = OTSYS_TIME();
 
-	auto it = ipConnectMap.find(clientIP);
-	if (it == ipConnectMap.end()) {
-		ipConnectMap.emplace(clientIP, ConnectBlock(currentTime, 0, 1));
+	if (currentTime >= shard.nextEviction) {
+		shard.nextEviction = currentTime + EVICTION_INTERVAL;
+		std::erase_if(shard.ipConnectMap, [currentTime](const auto& it) {
+			return it.second.lastAttempt + EVICTION_INTERVAL <= currentTime && it.second.blockTime <= currentTime;
+		});
+	}
+
+	auto it = shard.ipConnectMap.find(clientIP);
+	if (it == shard.ipConnectMap.end()) {
+		shard.ipConnectMap.emplace(clientIP, ConnectBlock(currentTime, 0, 1));
 		return true;
 	}
 
@@ -44,64 +139,201 @@ bool Ban::acceptConnection(const uint32_t clientIP)
 	return true;
 }
 
+size_t Ban::getTrackedCount()
+{
+	size_t count = 0;
+	for (Shard& shard : shards) {
+		std::lock_guard<std::mutex> lockClass(shard.lock);
+		count += shard.ipConnectMap.size();
+	}
+	return count;
+}
+
+bool IOBan::loadBans(Database& db)
+{
+	BanTable table;
+	if (!loadBanTable(db, table)) {
+		return false;
+	}
+
+	std::unique_lock<std::shared_mutex> lockClass(banTableLock);
+	banTable = std::move(table);
+	return true;
+}
+
+void IOBan::reloadBans()
+{
+	const uint32_t interval = getInteger(ConfigManager::BAN_REFRESH_INTERVAL);
+	if (interval == 0) {
+		return;
+	}
+
+	g_scheduler.addEvent(createSchedulerTask(interval, []() {
+		uint64_t writes;
+		{
+			std::shared_lock<std::shared_mutex> lockClass(banTableLock);
+			writes = banTableWrites;
+		}
+
+		g_databaseTasks.addJob([writes](Database& db) {
+			BanTable table;
+			if (loadBanTable(db, table)) {
+				std::unique_lock<std::shared_mutex> lockClass(banTableLock);
+				if (banTableWrites == writes) {
+					banTable = std::move(table);
+				}
+			} else {
+				std::cout << "[Error - IOBan::reloadBans] Could not read the bans, keeping the ones in memory."
+				          << std::endl;
+			}
+			g_dispatcher.addTask([]() { reloadBans(); });
+		});
+	}));
+}
+
 bool IOBan::isAccountBanned(uint32_t accountId, BanInfo& banInfo)
 {
+	{
+		std::shared_lock<std::shared_mutex> lockClass(banTableLock);
+		auto it = banTable.accountBans.find(accountId);
+		if (it == banTable.accountBans.end()) {
+			return false;
+		}
+
+		if (!isExpired(it->second)) {
+			banInfo = it->second.info;
+			return true;
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lockClass(banTableLock);
+	auto it = banTable.accountBans.find(accountId);
+	if (it == banTable.accountBans.end() || !isExpired(it->second)) {
+		// changed while the lock was released
+		lockClass.unlock();
+		return isAccountBanned(accountId, banInfo);
+	}
+
+	// Move the ban to history if it has expired
+	const BanEntry& entry = it->second;
 	Database& db = Database::getInstance();
+	g_databaseTasks.addTask(fmt::format(
+	    "INSERT INTO `account_ban_history` (`account_id`, `reason`, `banned_at`, `expired_at`, `banned_by`) VALUES ({:d}, {:s}, {:d}, {:d}, {:d})",
+	    accountId, db.escapeString(entry.info.reason), entry.bannedAt, entry.info.expiresAt, entry.bannedById));
+	g_databaseTasks.addTask(fmt::format("DELETE FROM `account_bans` WHERE `account_id` = {:d}", accountId));
+	banTable.accountBans.erase(it);
+	++banTableWrites;
+	return false;
+}
+
+bool IOBan::isIpBanned(const uint32_t clientIP, BanInfo& banInfo)
+{
+	if (clientIP == 0) {
+		return false;
+	}
+
+	{
+		std::shared_lock<std::shared_mutex> lockClass(banTableLock);
+		auto it = banTable.ipBans.find(clientIP);
+		if (it == banTable.ipBans.end()) {
+			return false;
+		}
+
+		if (!isExpired(it->second)) {
+			banInfo = it->second.info;
+			return true;
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lockClass(banTableLock);
+	auto it = banTable.ipBans.find(clientIP);
+	if (it == banTable.ipBans.end() || !isExpired(it->second)) {
+		lockClass.unlock();
+		return isIpBanned(clientIP, banInfo);
+	}
+
+	g_databaseTasks.addTask(fmt::format("DELETE FROM `ip_bans` WHERE `ip` = {:d}", clientIP));
+	banTable.ipBans.erase(it);
+	++banTableWrites;
+	return false;
+}
+
+bool IOBan::isPlayerNamelocked(uint32_t playerId)
+{
+	std::shared_lock<std::shared_mutex> lockClass(banTableLock);
+	return banTable.namelocks.contains(playerId);
+}
 
-	DBResult_ptr result = db.storeQuery(fmt::format(
-	    "SELECT `reason`, `expires_at`, `banned_at`, `banned_by`, (SELECT `name` FROM `players` WHERE `id` = `banned_by`) AS `name` FROM `account_bans` WHERE `account_id` = {:d}",
-	    accountId));
-	if (!result) {
+bool IOBan::addAccountBan(uint32_t accountId, std::string_view reason, time_t expiresAt, uint32_t bannedById,
+                          std::string_view bannedBy)
+{
+	BanInfo banInfo;
+	if (isAccountBanned(accountId, banInfo)) {
 		return false;
 	}
 
-	int64_t expiresAt = result->getNumber<int64_t>("expires_at");
-	if (expiresAt != 0 && time(nullptr) > expiresAt) {
-		// Move the ban to history if it has expired
-		g_databaseTasks.addTask(fmt::format(
-		    "INSERT INTO `account_ban_history` (`account_id`, `reason`, `banned_at`, `expired_at`, `banned_by`) VALUES ({:d}, {:s}, {:d}, {:d}, {:d})",
-		    accountId, db.escapeString(result->getString("reason")), result->getNumber<time_t>("banned_at"), expiresAt,
-		    result->getNumber<uint32_t>("banned_by")));
-		g_databaseTasks.addTask(fmt::format("DELETE FROM `account_bans` WHERE `account_id` = {:d}", accountId));
+	const time_t bannedAt = time(nullptr);
+
+	std::unique_lock<std::shared_mutex> lockClass(banTableLock);
+	auto [it, inserted] = banTable.accountBans.try_emplace(
+	    accountId, BanEntry{{std::string{bannedBy}, std::string{reason}, expiresAt}, bannedAt, bannedById});
+	if (!inserted) {
 		return false;
 	}
+	++banTableWrites;
 
-	banInfo.expiresAt = expiresAt;
-	banInfo.reason = result->getString("reason");
-	banInfo.bannedBy = result->getString("name");
+	Database& db = Database::getInstance();
+	g_databaseTasks.addTask(fmt::format(
+	    "INSERT INTO `account_bans` (`account_id`, `reason`, `banned_at`, `expires_at`, `banned_by`) VALUES ({:d}, {:s}, {:d}, {:d}, {:d})",
+	    accountId, db.escapeString(reason), bannedAt, expiresAt, bannedById));
 	return true;
 }
 
-bool IOBan::isIpBanned(const uint32_t clientIP, BanInfo& banInfo)
+bool IOBan::removeAccountBan(uint32_t accountId)
 {
-	if (clientIP == 0) {
+	std::unique_lock<std::shared_mutex> lockClass(banTableLock);
+	if (banTable.accountBans.erase(accountId) == 0) {
 		return false;
 	}
+	++banTableWrites;
 
-	Database& db = Database::getInstance();
+	g_databaseTasks.addTask(fmt::format("DELETE FROM `account_bans` WHERE `account_id` = {:d}", accountId));
+	return true;
+}
 
-	DBResult_ptr result = db.storeQuery(fmt::format(
-	    "SELECT `reason`, `expires_at`, (SELECT `name` FROM `players` WHERE `id` = `banned_by`) AS `name` FROM `ip_bans` WHERE `ip` = {:d}",
-	    clientIP));
-	if (!result) {
+bool IOBan::addIpBan(uint32_t clientIP, std::string_view reason, time_t expiresAt, uint32_t bannedById,
+                     std::string_view bannedBy)
+{
+	BanInfo banInfo;
+	if (clientIP == 0 || isIpBanned(clientIP, banInfo)) {
 		return false;
 	}
 
-	int64_t expiresAt = result->getNumber<int64_t>("expires_at");
-	if (expiresAt != 0 && time(nullptr) > expiresAt) {
-		g_databaseTasks.addTask(fmt::format("DELETE FROM `ip_bans` WHERE `ip` = {:d}", clientIP));
+	const time_t bannedAt = time(nullptr);
+
+	std::unique_lock<std::shared_mutex> lockClass(banTableLock);
+	auto [it, inserted] = banTable.ipBans.try_emplace(
+	    clientIP, BanEntry{{std::string{bannedBy}, std::string{reason}, expiresAt}, bannedAt, bannedById});
+	if (!inserted) {
 		return false;
 	}
+	++banTableWrites;
 
-	banInfo.expiresAt = expiresAt;
-	banInfo.reason = result->getString("reason");
-	banInfo.bannedBy = result->getString("name");
+	Database& db = Database::getInstance();
+	g_databaseTasks.addTask(fmt::format(
+	    "INSERT INTO `ip_bans` (`ip`, `reason`, `banned_at`, `expires_at`, `banned_by`) VALUES ({:d}, {:s}, {:d}, {:d}, {:d})",
+	    clientIP, db.escapeString(reason), bannedAt, expiresAt, bannedById));
 	return true;
 }
 
-bool IOBan::isPlayerNamelocked(uint32_t playerId)
+bool IOBan::removeIpBan(uint32_t clientIP)
 {
-	return Database::getInstance()
-	    .storeQuery(fmt::format("SELECT 1 FROM `player_namelocks` WHERE `player_id` = {:d}", playerId))
-	    .get();
+	std::unique_lock<std::shared_mutex> lockClass(banTableLock);
+	if (banTable.ipBans.erase(clientIP) == 0) {
+		return false;
+	}
+	++banTableWrites;
+
+	g_databaseTasks.addTask(fmt::format("DELETE FROM `ip_bans` WHERE `ip` = {:d}", clientIP));
+	return true;
 }
@@ -6,6 +6,8 @@
 
 #include "connection.h"
 
+class Database;
+
 struct BanInfo
 {
 	std::string bannedBy;
@@ -24,24 +26,56 @@ struct ConnectBlock
 	uint32_t count;
 };
 
-using IpConnectMap = std::map<uint32_t, ConnectBlock>;
+using IpConnectMap = std::unordered_map<uint32_t, ConnectBlock>;
 
+// Connection throttle per address. Addresses are spread over independently locked shards so accepts on different
+// network threads rarely contend, and each shard forgets addresses that went quiet.
 class Ban
 {
 public:
 	bool acceptConnection(const uint32_t clientIP);
 
+	// addresses currently tracked, for statistics
+	size_t getTrackedCount();
+
+	static constexpr size_t SHARD_COUNT = 16;
+	// an address not seen for this long would start over anyway, so it is dropped
+	static constexpr uint64_t EVICTION_INTERVAL = 60 * 1000;
+
 private:
-	IpConnectMap ipConnectMap;
-	std::recursive_mutex lock;
+	struct alignas(64) Shard
+	{
+		std::mutex lock;
+		IpConnectMap ipConnectMap;
+		uint64_t nextEviction = 0;
+	};
+
+	Shard& getShard(uint32_t clientIP) { return shards[((clientIP * 0x9E3779B1u) >> 16) % SHARD_COUNT]; }
+
+	std::array<Shard, SHARD_COUNT> shards;
 };
 
+// Account bans, IP bans and namelocks are kept in memory: loaded at startup, written through by the add and remove
+// functions and re-read every banRefreshInterval to pick up changes made outside the server. Lookups never query the
+// database.
 class IOBan
 {
 public:
+	static bool loadBans(Database& db);
+	// re-reads the tables on the database worker and schedules the next reload
+	static void reloadBans();
+
 	static bool isAccountBanned(uint32_t accountId, BanInfo& banInfo);
 	static bool isIpBanned(const uint32_t clientIP, BanInfo& banInfo);
 	static bool isPlayerNamelocked(uint32_t playerId);
+
+	// false if there already is a ban
+	static bool addAccountBan(uint32_t accountId, std::string_view reason, time_t expiresAt, uint32_t bannedById,
+	                          std::string_view bannedBy);
+	static bool removeAccountBan(uint32_t accountId);
+	static bool addIpBan(uint32_t clientIP, std::string_view reason, time_t expiresAt, uint32_t bannedById,
+	                     std::string_view bannedBy);
+	static bool removeIpBan(uint32_t clientIP);
 };
 
 #endif // FS_BAN_H
@@ -217,6 +217,7 @@ bool ConfigManager::load()
 		}
 
 		integers[Integer::STATUS_PORT] = getGlobalInteger(L, "statusProtocolPort", 7171);
+		integers[Integer::NETWORK_THREADS] = getGlobalInteger(L, "networkThreads", 1);
 
 		integers[Integer::MARKET_OFFER_DURATION] = getGlobalInteger(L, "marketOfferDuration", 30 * 24 * 60 * 60);
 	}
@@ -258,6 +259,7 @@ bool ConfigManager::load()
 	booleans[Boolean::MONSTER_OVERSPAWN] = getGlobalBoolean(L, "monsterOverspawn", false);
 	booleans[Boolean::ACCOUNT_MANAGER] = getGlobalBoolean(L, "accountManager", true);
 	booleans[Boolean::MANASHIELD_BREAKABLE] = getGlobalBoolean(L, "useBreakableManaShield", false);
+	booleans[Boolean::MONSTER_THINK_LOD] = getGlobalBoolean(L, "monsterThinkLevelOfDetail", true);
 
 	strings[String::DEFAULT_PRIORITY] = getGlobalString(L, "defaultPriority", "high");
 	strings[String::SERVER_NAME] = getGlobalString(L, "serverName", "");
@@ -276,6 +278,8 @@ bool ConfigManager::load()
 	integers[Integer::DEFAULT_DESPAWNRANGE] = Monster::despawnRange;
 	integers[Integer::DEFAULT_DESPAWNRADIUS] = Monster::despawnRadius;
 	integers[Integer::DEFAULT_WALKTOSPAWNRADIUS] = getGlobalInteger(L, "walkToSpawnRadius", 15);
+	integers[Integer::MONSTER_FULL_THINK_RANGE] = getGlobalInteger(L, "monsterFullThinkRange", 7);
+	integers[Integer::MONSTER_REDUCED_THINK_INTERVAL] = getGlobalInteger(L, "monsterReducedThinkInterval", 1000);
 	integers[Integer::RATE_EXPERIENCE] = getGlobalInteger(L, "rateExp", 5);
 	integers[Integer::RATE_SKILL] = getGlobalInteger(L, "rateSkill", 3);
 	integers[Integer::RATE_LOOT] = getGlobalInteger(L, "rateLoot", 2);
@@ -291,6 +295,10 @@ bool ConfigManager::load()
 	integers[Integer::PROTECTION_LEVEL] = getGlobalInteger(L, "protectionLevel", 1);
 	integers[Integer::DEATH_LOSE_PERCENT] = getGlobalInteger(L, "deathLosePercent", -1);
 	integers[Integer::STATUSQUERY_TIMEOUT] = getGlobalInteger(L, "statusTimeout", 5000);
+	integers[Integer::STATUS_CACHE_INTERVAL] = getGlobalInteger(L, "statusCacheInterval", 1000);
+	integers[Integer::BAN_REFRESH_INTERVAL] = getGlobalInteger(L, "banRefreshInterval", 60 * 1000);
+	integers[Integer::STORAGE_FLUSH_INTERVAL] = getGlobalInteger(L, "storageFlushInterval", 30 * 1000);
+	integers[Integer::GUILD_REFRESH_INTERVAL] = getGlobalInteger(L, "guildRefreshInterval", 60 * 1000);
 	integers[Integer::FRAG_TIME] = getGlobalInteger(L, "timeToDecreaseFrags", 24 * 60 * 60);
 	integers[Integer::WHITE_SKULL_TIME] = getGlobalInteger(L, "whiteSkullTime", 15 * 60);
 	integers[Integer::STAIRHOP_DELAY] = getGlobalInteger(L, "stairJumpExhaustion", 2000);
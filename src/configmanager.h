@@ -47,6 +47,7 @@ enum Boolean
 	MONSTER_OVERSPAWN,
 	ACCOUNT_MANAGER,
 	MANASHIELD_BREAKABLE,
+	MONSTER_THINK_LOD,
 
 	LAST_BOOLEAN /* this must be the last one */
 };
@@ -98,6 +99,10 @@ enum Integer
 	PROTECTION_LEVEL,
 	DEATH_LOSE_PERCENT,
 	STATUSQUERY_TIMEOUT,
+	STATUS_CACHE_INTERVAL,
+	BAN_REFRESH_INTERVAL,
+	STORAGE_FLUSH_INTERVAL,
+	GUILD_REFRESH_INTERVAL,
 	FRAG_TIME,
 	WHITE_SKULL_TIME,
 	GAME_PORT,
@@ -127,6 +132,9 @@ enum Integer
 	RANGE_USE_ITEM_INTERVAL,
 	RANGE_USE_ITEM_EX_INTERVAL,
 	RANGE_ROTATE_ITEM_INTERVAL,
+	MONSTER_FULL_THINK_RANGE,
+	MONSTER_REDUCED_THINK_INTERVAL,
+	NETWORK_THREADS,
 
 	LAST_INTEGER /* this must be the last one */
 };
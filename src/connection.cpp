@@ -33,12 +33,14 @@ void ConnectionManager::closeAll()
 	std::lock_guard<std::mutex> lockClass(connectionManagerLock);
 
 	for (const auto& connection : connections) {
-		try {
-			boost::system::error_code error;
-			connection->socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
-			connection->socket.close(error);
-		} catch (boost::system::system_error&) {
-		}
+		boost::asio::post(connection->strand, [connection]() {
+			try {
+				boost::system::error_code error;
+				connection->socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
+				connection->socket.close(error);
+			} catch (boost::system::system_error&) {
+			}
+		});
 	}
 	connections.clear();
 }
@@ -50,7 +52,11 @@ void Connection::close(bool force)
 	// any thread
 	ConnectionManager::getInstance().releaseConnection(shared_from_this());
 
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
+	boost::asio::dispatch(strand, [thisPtr = shared_from_this(), force]() { thisPtr->internalClose(force); });
+}
+
+void Connection::internalClose(bool force)
+{
 	if (closed) {
 		return;
 	}
@@ -82,7 +88,11 @@ void Connection::closeSocket()
 	}
 }
 
-Connection::~Connection() { closeSocket(); }
+Connection::~Connection()
+{
+	closeSocket();
+	NetworkMessage::releaseBuffer(readBuffer, readCapacity);
+}
 
 void Connection::accept(Protocol_ptr protocol)
 {
@@ -94,29 +104,34 @@ void Connection::accept(Protocol_ptr protocol)
 
 void Connection::accept()
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
+	boost::asio::dispatch(strand, [thisPtr = shared_from_this()]() { thisPtr->read(); });
+}
+
+void Connection::read()
+{
 	try {
 		readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
-		readTimer.async_wait(
-		    [thisPtr = std::weak_ptr<Connection>(shared_from_this())](const boost::system::error_code& error) {
+		readTimer.async_wait(boost::asio::bind_executor(
+		    strand, [thisPtr = ConnectionWeak_ptr(shared_from_this())](const boost::system::error_code& error) {
 			    Connection::handleTimeout(thisPtr, error);
-		    });
-
-		// Read size of the first packet
-		boost::asio::async_read(
-		    socket, boost::asio::buffer(msg.getBuffer(), NetworkMessage::HEADER_LENGTH),
-		    [thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) {
-			    thisPtr->parseHeader(error);
-		    });
+		    }));
+
+		// Take whatever the client has sent so far, packets are framed in onRead
+		assert(readLength < readCapacity);
+		socket.async_read_some(
+		    boost::asio::buffer(readBuffer + readLength, readCapacity - readLength),
+		    boost::asio::bind_executor(strand, [thisPtr = shared_from_this()](const boost::system::error_code& error,
+		                                                                      size_t bytes_transferred) {
+			    thisPtr->onRead(error, bytes_transferred);
+		    }));
 	} catch (boost::system::system_error& e) {
-		std::cout << "[Network error - Connection::accept] " << e.what() << std::endl;
+		std::cout << "[Network error - Connection::read] " << e.what() << std::endl;
 		close(FORCE_CLOSE);
 	}
 }
 
-void Connection::parseHeader(const boost::system::error_code& error)
+void Connection::onRead(const boost::system::error_code& error, size_t bytes_transferred)
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
 	readTimer.cancel();
 
 	if (error) {
@@ -126,56 +141,77 @@ void Connection::parseHeader(const boost::system::error_code& error)
 		return;
 	}
 
-	uint32_t timePassed = std::max<uint32_t>(1, (time(nullptr) - timeConnected) + 1);
-	if ((++packetsSent / timePassed) > getInteger(ConfigManager::MAX_PACKETS_PER_SECOND)) {
-		std::cout << convertIPToString(getIP()) << " disconnected for exceeding packet per second limit." << std::endl;
-		close();
-		return;
-	}
+	readLength += bytes_transferred;
+
+	size_t position = 0, pendingPacketLength = 0;
+	while (readLength - position >= NetworkMessage::HEADER_LENGTH) {
+		uint16_t size = static_cast<uint16_t>(readBuffer[position] | readBuffer[position + 1] << 8);
+		if (size == 0 || size >= NETWORKMESSAGE_MAXSIZE - 16) {
+			close(FORCE_CLOSE);
+			return;
+		}
+
+		const size_t packetLength = NetworkMessage::HEADER_LENGTH + size;
+		if (readLength - position < packetLength) {
+			pendingPacketLength = packetLength;
+			break;
+		}
+
+		uint32_t timePassed = std::max<uint32_t>(1, (time(nullptr) - timeConnected) + 1);
+		if ((++packetsSent / timePassed) > getInteger(ConfigManager::MAX_PACKETS_PER_SECOND)) {
+			std::cout << convertIPToString(getIP()) << " disconnected for exceeding packet per second limit."
+			          << std::endl;
+			close();
+			return;
+		}
+
+		if (timePassed > 2) {
+			timeConnected = time(nullptr);
+			packetsSent = 0;
+		}
 
-	if (timePassed > 2) {
-		timeConnected = time(nullptr);
-		packetsSent = 0;
+		msg.reserve(packetLength + NetworkMessage::INITIAL_BUFFER_POSITION);
+		std::memcpy(msg.getBuffer(), readBuffer + position, packetLength);
+		msg.setLength(static_cast<NetworkMessage::MsgSize_t>(packetLength));
+		msg.setBodyPosition();
+		position += packetLength;
+
+		parsePacket();
+		if (closed) {
+			return;
+		}
 	}
 
-	uint16_t size = msg.getLengthHeader();
-	if (size == 0 || size >= NETWORKMESSAGE_MAXSIZE - 16) {
-		close(FORCE_CLOSE);
-		return;
+	// keep the incomplete tail at the front of the buffer
+	readLength -= position;
+	if (readLength != 0 && position != 0) {
+		std::memmove(readBuffer, readBuffer + position, readLength);
 	}
 
-	try {
-		readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
-		readTimer.async_wait(
-		    [thisPtr = std::weak_ptr<Connection>(shared_from_this())](const boost::system::error_code& error) {
-			    Connection::handleTimeout(thisPtr, error);
-		    });
-
-		// Read packet content
-		msg.setLength(size + NetworkMessage::HEADER_LENGTH);
-		boost::asio::async_read(
-		    socket, boost::asio::buffer(msg.getBodyBuffer(), size),
-		    [thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) {
-			    thisPtr->parsePacket(error);
-		    });
-	} catch (boost::system::system_error& e) {
-		std::cout << "[Network error - Connection::parseHeader] " << e.what() << std::endl;
-		close(FORCE_CLOSE);
+	// grow for a packet that does not fit, go back to the smallest size class once a large one has been framed
+	if (pendingPacketLength > readCapacity) {
+		resizeReadBuffer(pendingPacketLength);
+	} else if (readCapacity > NetworkMessage::MIN_BUFFER_SIZE && readLength < NetworkMessage::MIN_BUFFER_SIZE &&
+	           pendingPacketLength <= NetworkMessage::MIN_BUFFER_SIZE) {
+		resizeReadBuffer(NetworkMessage::MIN_BUFFER_SIZE);
 	}
+
+	read();
 }
 
-void Connection::parsePacket(const boost::system::error_code& error)
+void Connection::resizeReadBuffer(size_t size)
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
-	readTimer.cancel();
+	NetworkMessage::MsgSize_t newCapacity;
+	uint8_t* newBuffer = NetworkMessage::acquireBuffer(newCapacity, size);
+	std::memcpy(newBuffer, readBuffer, readLength);
+	NetworkMessage::releaseBuffer(readBuffer, readCapacity);
 
-	if (error) {
-		close(FORCE_CLOSE);
-		return;
-	} else if (closed) {
-		return;
-	}
+	readBuffer = newBuffer;
+	readCapacity = newCapacity;
+}
 
+void Connection::parsePacket()
+{
 	// Check packet checksum
 	uint32_t checksum;
 	int32_t len = msg.getLength() - msg.getBufferPosition() - NetworkMessage::CHECKSUM_LENGTH;
@@ -211,80 +247,99 @@ void Connection::parsePacket(const boost::system::error_code& error)
 	} else {
 		protocol->onRecvMessage(msg); // Send the packet to the current protocol
 	}
-
-	try {
-		readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
-		readTimer.async_wait(
-		    [thisPtr = std::weak_ptr<Connection>(shared_from_this())](const boost::system::error_code& error) {
-			    Connection::handleTimeout(thisPtr, error);
-		    });
-
-		// Wait to the next packet
-		boost::asio::async_read(
-		    socket, boost::asio::buffer(msg.getBuffer(), NetworkMessage::HEADER_LENGTH),
-		    [thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) {
-			    thisPtr->parseHeader(error);
-		    });
-	} catch (boost::system::system_error& e) {
-		std::cout << "[Network error - Connection::parsePacket] " << e.what() << std::endl;
-		close(FORCE_CLOSE);
-	}
 }
 
 void Connection::send(const OutputMessage_ptr& msg)
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
-	if (closed) {
-		return;
-	}
+	// any thread
+	boost::asio::dispatch(strand, [thisPtr = shared_from_this(), msg]() {
+		if (thisPtr->closed) {
+			return;
+		}
 
-	bool noPendingWrite = messageQueue.empty();
-	messageQueue.emplace_back(msg);
-	if (noPendingWrite) {
-		internalSend(msg);
-	}
+		thisPtr->messageQueue.emplace_back(msg);
+
+		const auto depth = static_cast<uint32_t>(thisPtr->messageQueue.size());
+		thisPtr->queueDepth.store(depth, std::memory_order_relaxed);
+		if (depth > thisPtr->maxQueueDepth.load(std::memory_order_relaxed)) {
+			thisPtr->maxQueueDepth.store(depth, std::memory_order_relaxed);
+		}
+
+		if (thisPtr->pendingWrites == 0) {
+			thisPtr->internalSend();
+		}
+	});
 }
 
-void Connection::internalSend(const OutputMessage_ptr& msg)
+void Connection::internalSend()
 {
-	protocol->onSendMessage(msg);
+	// every queued message is prepared exactly once, when it joins a write
+	size_t bytes = 0;
+	writeBuffers.clear();
+	for (const OutputMessage_ptr& msg : messageQueue) {
+		if (!writeBuffers.empty() && bytes + msg->getLength() > CONNECTION_WRITE_BUDGET) {
+			break;
+		}
+
+		protocol->onSendMessage(msg);
+		writeBuffers.emplace_back(msg->getOutputBuffer(), msg->getLength());
+		bytes += msg->getLength();
+	}
+	pendingWrites = writeBuffers.size();
+
 	try {
 		writeTimer.expires_from_now(std::chrono::seconds(CONNECTION_WRITE_TIMEOUT));
-		writeTimer.async_wait(
-		    [thisPtr = std::weak_ptr<Connection>(shared_from_this())](const boost::system::error_code& error) {
+		writeTimer.async_wait(boost::asio::bind_executor(
+		    strand, [thisPtr = ConnectionWeak_ptr(shared_from_this())](const boost::system::error_code& error) {
 			    Connection::handleTimeout(thisPtr, error);
-		    });
-
-		boost::asio::async_write(
-		    socket, boost::asio::buffer(msg->getOutputBuffer(), msg->getLength()),
-		    [thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) {
-			    thisPtr->onWriteOperation(error);
-		    });
+		    }));
+
+		boost::asio::async_write(socket, writeBuffers,
+		                         boost::asio::bind_executor(strand, [thisPtr = shared_from_this()](
+		                                                                const boost::system::error_code& error,
+		                                                                size_t bytes_transferred) {
+			                         thisPtr->onWriteOperation(error, bytes_transferred);
+		                         }));
 	} catch (boost::system::system_error& e) {
 		std::cout << "[Network error - Connection::internalSend] " << e.what() << std::endl;
 		close(FORCE_CLOSE);
 	}
 }
 
-uint32_t Connection::getIP()
+ConnectionStatistics Connection::getStatistics() const
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
+	ConnectionStatistics statistics;
+	statistics.writes = writes.load(std::memory_order_relaxed);
+	statistics.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+	statistics.messagesWritten = messagesWritten.load(std::memory_order_relaxed);
+	statistics.queueDepth = queueDepth.load(std::memory_order_relaxed);
+	statistics.maxQueueDepth = maxQueueDepth.load(std::memory_order_relaxed);
+	return statistics;
+}
 
+void Connection::updateRemoteIp()
+{
 	// IP-address is expressed in network byte order
 	boost::system::error_code error;
 	const boost::asio::ip::tcp::endpoint endpoint = socket.remote_endpoint(error);
 	if (error) {
-		return 0;
+		remoteIp = 0;
+		return;
 	}
 
-	return htonl(endpoint.address().to_v4().to_ulong());
+	remoteIp = htonl(endpoint.address().to_v4().to_ulong());
 }
 
-void Connection::onWriteOperation(const boost::system::error_code& error)
+void Connection::onWriteOperation(const boost::system::error_code& error, size_t bytes_transferred)
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
 	writeTimer.cancel();
-	messageQueue.pop_front();
+	messageQueue.erase(messageQueue.begin(), messageQueue.begin() + pendingWrites);
+	queueDepth.store(static_cast<uint32_t>(messageQueue.size()), std::memory_order_relaxed);
+
+	writes.fetch_add(1, std::memory_order_relaxed);
+	bytesWritten.fetch_add(bytes_transferred, std::memory_order_relaxed);
+	messagesWritten.fetch_add(pendingWrites, std::memory_order_relaxed);
+	pendingWrites = 0;
 
 	if (error) {
 		messageQueue.clear();
@@ -293,7 +348,7 @@ void Connection::onWriteOperation(const boost::system::error_code& error)
 	}
 
 	if (!messageQueue.empty()) {
-		internalSend(messageQueue.front());
+		internalSend();
 	} else if (closed) {
 		closeSocket();
 	}
@@ -10,6 +10,8 @@
 
 inline constexpr int32_t CONNECTION_WRITE_TIMEOUT = 30;
 inline constexpr int32_t CONNECTION_READ_TIMEOUT = 30;
+// soft limit for the bytes gathered into a single socket write
+inline constexpr size_t CONNECTION_WRITE_BUDGET = 64 * 1024;
 
 class Protocol;
 using Protocol_ptr = std::shared_ptr<Protocol>;
@@ -24,6 +26,15 @@ class ServicePort;
 using ServicePort_ptr = std::shared_ptr<ServicePort>;
 using ConstServicePort_ptr = std::shared_ptr<const ServicePort>;
 
+struct ConnectionStatistics
+{
+	uint64_t writes = 0;
+	uint64_t bytesWritten = 0;
+	uint64_t messagesWritten = 0;
+	uint32_t queueDepth = 0;
+	uint32_t maxQueueDepth = 0;
+};
+
 class ConnectionManager
 {
 public:
@@ -57,12 +68,15 @@ public:
 	};
 
 	Connection(boost::asio::io_service& io_service, ConstServicePort_ptr service_port) :
+	    strand(io_service),
 	    readTimer(io_service),
 	    writeTimer(io_service),
 	    service_port(std::move(service_port)),
 	    socket(io_service),
 	    timeConnected(time(nullptr))
-	{}
+	{
+		readBuffer = NetworkMessage::acquireBuffer(readCapacity);
+	}
 	~Connection();
 
 	friend class ConnectionManager;
@@ -74,31 +88,55 @@ public:
 
 	void send(const OutputMessage_ptr& msg);
 
-	uint32_t getIP();
+	uint32_t getIP() const { return remoteIp; }
 	uint32_t getLastIp() const { return lastIp; }
 
+	// any thread
+	ConnectionStatistics getStatistics() const;
+
 private:
-	void parseHeader(const boost::system::error_code& error);
-	void parsePacket(const boost::system::error_code& error);
+	void updateRemoteIp();
 
-	void onWriteOperation(const boost::system::error_code& error);
+	void read();
+	void onRead(const boost::system::error_code& error, size_t bytes_transferred);
+	void parsePacket();
+	// moves the unframed bytes into a pooled buffer that holds size bytes
+	void resizeReadBuffer(size_t size);
+
+	void onWriteOperation(const boost::system::error_code& error, size_t bytes_transferred);
 
 	static void handleTimeout(ConnectionWeak_ptr connectionWeak, const boost::system::error_code& error);
 
+	void internalClose(bool force);
 	void closeSocket();
-	void internalSend(const OutputMessage_ptr& msg);
+	void internalSend();
 
 	boost::asio::ip::tcp::socket& getSocket() { return socket; }
 	friend class ServicePort;
 
 	NetworkMessage msg;
 
+	// bytes received from the socket that have not been framed into packets yet, kept in the smallest pooled size
+	// class unless a partial packet needs more room
+	uint8_t* readBuffer = nullptr;
+	NetworkMessage::MsgSize_t readCapacity = 0;
+	size_t readLength = 0;
+
+	// every handler touching the socket, timers or queue runs on this strand
+	boost::asio::io_service::strand strand;
 	boost::asio::steady_timer readTimer;
 	boost::asio::steady_timer writeTimer;
 
-	std::recursive_mutex connectionLock;
+	std::deque<OutputMessage_ptr> messageQueue;
+	// buffers of the first pendingWrites messages in messageQueue, written with one gathered write
+	std::vector<boost::asio::const_buffer> writeBuffers;
+	size_t pendingWrites = 0;
 
-	std::list<OutputMessage_ptr> messageQueue;
+	std::atomic<uint64_t> writes = 0;
+	std::atomic<uint64_t> bytesWritten = 0;
+	std::atomic<uint64_t> messagesWritten = 0;
+	std::atomic<uint32_t> queueDepth = 0;
+	std::atomic<uint32_t> maxQueueDepth = 0;
 
 	ConstServicePort_ptr service_port;
 	Protocol_ptr protocol;
@@ -107,6 +145,7 @@ private:
 
 	time_t timeConnected;
 	uint32_t packetsSent = 0;
+	std::atomic<uint32_t> remoteIp = 0;
 	uint32_t lastIp = 0;
 
 	bool closed = false;
@@ -421,6 +421,9 @@ void Container::addThing(int32_t index, Thing* thing)
 	item->setParent(this);
 	itemlist.push_front(item);
 	updateItemWeight(item->getWeight());
+	if (Player* player = getHoldingPlayer()) {
+		player->addItemTypeCounts(item, 1);
+	}
 
 	// send change to client
 	if (getParent() && (getParent() != VirtualCylinder::virtualCylinder)) {
@@ -432,6 +435,9 @@ void Container::addItemBack(Item* item)
 {
 	addItem(item);
 	updateItemWeight(item->getWeight());
+	if (Player* player = getHoldingPlayer()) {
+		player->addItemTypeCounts(item, 1);
+	}
 
 	// send change to client
 	if (getParent() && (getParent() != VirtualCylinder::virtualCylinder)) {
@@ -451,11 +457,20 @@ void Container::updateThing(Thing* thing, uint16_t itemId, uint32_t count)
 		return /*RETURNVALUE_NOTPOSSIBLE*/;
 	}
 
+	Player* player = getHoldingPlayer();
+	if (player) {
+		player->addItemTypeCount(item->getID(), -item->getItemCount());
+	}
+
 	const int32_t oldWeight = item->getWeight();
 	item->setID(itemId);
 	item->setSubType(static_cast<uint16_t>(count));
 	updateItemWeight(-oldWeight + item->getWeight());
 
+	if (player) {
+		player->addItemTypeCount(item->getID(), item->getItemCount());
+	}
+
 	// send change to client
 	if (getParent()) {
 		onUpdateContainerItem(index, item, item);
@@ -477,6 +492,10 @@ void Container::replaceThing(uint32_t index, Thing* thing)
 	itemlist[index] = item;
 	item->setParent(this);
 	updateItemWeight(-static_cast<int32_t>(replacedItem->getWeight()) + item->getWeight());
+	if (Player* player = getHoldingPlayer()) {
+		player->addItemTypeCounts(replacedItem, -1);
+		player->addItemTypeCounts(item, 1);
+	}
 
 	// send change to client
 	if (getParent()) {
@@ -498,8 +517,13 @@ void Container::removeThing(Thing* thing, uint32_t count)
 		return /*RETURNVALUE_NOTPOSSIBLE*/;
 	}
 
+	Player* player = getHoldingPlayer();
 	if (item->isStackable() && count != item->getItemCount()) {
 		uint8_t newCount = static_cast<uint8_t>(std::max<int32_t>(0, item->getItemCount() - count));
+		if (player) {
+			player->addItemTypeCount(item->getID(), newCount - item->getItemCount());
+		}
+
 		const int32_t oldWeight = item->getWeight();
 		item->setItemCount(newCount);
 		updateItemWeight(-oldWeight + item->getWeight());
@@ -510,6 +534,9 @@ void Container::removeThing(Thing* thing, uint32_t count)
 		}
 	} else {
 		updateItemWeight(-static_cast<int32_t>(item->getWeight()));
+		if (player) {
+			player->addItemTypeCounts(item, -1);
+		}
 
 		// send change to client
 		if (getParent()) {
@@ -615,6 +642,11 @@ void Container::internalAddThing(uint32_t, Thing* thing)
 	item->setParent(this);
 	itemlist.push_front(item);
 	updateItemWeight(item->getWeight());
+
+	// loading bypasses the count updates, they are built again on the next query
+	if (Player* player = getHoldingPlayer()) {
+		player->invalidateItemTypeCounts();
+	}
 }
 
 void Container::startDecaying()
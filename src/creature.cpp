@@ -311,25 +311,35 @@ void Creature::stopEventWalk()
 
 void Creature::updateMapCache()
 {
-	Tile* tile;
+	for (int32_t y = -maxWalkCacheHeight; y <= maxWalkCacheHeight; ++y) {
+		updateMapCacheRow(y);
+	}
+}
+
+void Creature::updateMapCacheRow(int32_t dy)
+{
 	const Position& myPos = getPosition();
-	Position pos(0, 0, myPos.z);
+	for (int32_t x = -maxWalkCacheWidth; x <= maxWalkCacheWidth; ++x) {
+		updateTileCache(g_game.map.getTile(myPos.x + x, myPos.y + dy, myPos.z), x, dy);
+	}
+}
 
+void Creature::updateMapCacheColumn(int32_t dx)
+{
+	const Position& myPos = getPosition();
 	for (int32_t y = -maxWalkCacheHeight; y <= maxWalkCacheHeight; ++y) {
-		for (int32_t x = -maxWalkCacheWidth; x <= maxWalkCacheWidth; ++x) {
-			pos.x = myPos.getX() + x;
-			pos.y = myPos.getY() + y;
-			tile = g_game.map.getTile(pos);
-			updateTileCache(tile, pos);
-		}
+		updateTileCache(g_game.map.getTile(myPos.x + dx, myPos.y + y, myPos.z), dx, y);
 	}
 }
 
 void Creature::updateTileCache(const Tile* tile, int32_t dx, int32_t dy)
 {
 	if (std::abs(dx) <= maxWalkCacheWidth && std::abs(dy) <= maxWalkCacheHeight) {
-		localMapCache[maxWalkCacheHeight + dy][maxWalkCacheWidth + dx] =
-		    tile && tile->queryAdd(0, *this, 1, FLAG_PATHFINDING | FLAG_IGNOREFIELDDAMAGE) == RETURNVALUE_NOERROR;
+		// tiles that block pathfinding for every kind of creature skip the per creature query
+		localMapCache.set(dx, dy,
+		                  tile && !tile->isPathBlocking() &&
+		                      tile->queryAdd(0, *this, 1, FLAG_PATHFINDING | FLAG_IGNOREFIELDDAMAGE) ==
+		                          RETURNVALUE_NOERROR);
 	}
 }
 
@@ -360,7 +370,7 @@ int32_t Creature::getWalkCache(const Position& pos) const
 
 	if (int32_t dx = pos.getOffsetX(myPos); std::abs(dx) <= maxWalkCacheWidth) {
 		if (int32_t dy = pos.getOffsetY(myPos); std::abs(dy) <= maxWalkCacheHeight) {
-			if (localMapCache[maxWalkCacheHeight + dy][maxWalkCacheWidth + dx]) {
+			if (localMapCache.test(dx, dy)) {
 				return 1;
 			}
 			return 0;
@@ -508,83 +518,20 @@ void Creature::onCreatureMove(Creature* creature, const Tile* newTile, const Pos
 
 		// update map cache
 		if (isMapLoaded) {
-			if (teleport || oldPos.z != newPos.z) {
+			const int32_t stepX = newPos.getOffsetX(oldPos);
+			const int32_t stepY = newPos.getOffsetY(oldPos);
+			if (teleport || oldPos.z != newPos.z || std::abs(stepX) > 1 || std::abs(stepY) > 1) {
 				updateMapCache();
 			} else {
-				const Position& myPos = getPosition();
-
-				if (oldPos.y > newPos.y) { // north
-					// shift y south
-					for (int32_t y = mapWalkHeight - 1; --y >= 0;) {
-						memcpy(localMapCache[y + 1], localMapCache[y], sizeof(localMapCache[y]));
-					}
-
-					// update 0
-					for (int32_t x = -maxWalkCacheWidth; x <= maxWalkCacheWidth; ++x) {
-						Tile* cacheTile =
-						    g_game.map.getTile(myPos.getX() + x, myPos.getY() - maxWalkCacheHeight, myPos.z);
-						updateTileCache(cacheTile, x, -maxWalkCacheHeight);
-					}
-				} else if (oldPos.y < newPos.y) { // south
-					// shift y north
-					for (int32_t y = 0; y <= mapWalkHeight - 2; ++y) {
-						memcpy(localMapCache[y], localMapCache[y + 1], sizeof(localMapCache[y]));
-					}
+				// only the row and column entering the window need to be queried
+				localMapCache.shift(stepX, stepY);
 
-					// update mapWalkHeight - 1
-					for (int32_t x = -maxWalkCacheWidth; x <= maxWalkCacheWidth; ++x) {
-						Tile* cacheTile =
-						    g_game.map.getTile(myPos.getX() + x, myPos.getY() + maxWalkCacheHeight, myPos.z);
-						updateTileCache(cacheTile, x, maxWalkCacheHeight);
-					}
+				if (stepY != 0) {
+					updateMapCacheRow(stepY < 0 ? -maxWalkCacheHeight : maxWalkCacheHeight);
 				}
 
-				if (oldPos.x < newPos.x) { // east
-					// shift y west
-					int32_t starty = 0;
-					int32_t endy = mapWalkHeight - 1;
-					int32_t dy = oldPos.getDistanceY(newPos);
-
-					if (dy < 0) {
-						endy += dy;
-					} else if (dy > 0) {
-						starty = dy;
-					}
-
-					for (int32_t y = starty; y <= endy; ++y) {
-						for (int32_t x = 0; x <= mapWalkWidth - 2; ++x) {
-							localMapCache[y][x] = localMapCache[y][x + 1];
-						}
-					}
-
-					// update mapWalkWidth - 1
-					for (int32_t y = -maxWalkCacheHeight; y <= maxWalkCacheHeight; ++y) {
-						Tile* cacheTile = g_game.map.getTile(myPos.x + maxWalkCacheWidth, myPos.y + y, myPos.z);
-						updateTileCache(cacheTile, maxWalkCacheWidth, y);
-					}
-				} else if (oldPos.x > newPos.x) { // west
-					// shift y east
-					int32_t starty = 0;
-					int32_t endy = mapWalkHeight - 1;
-					int32_t dy = oldPos.getDistanceY(newPos);
-
-					if (dy < 0) {
-						endy += dy;
-					} else if (dy > 0) {
-						starty = dy;
-					}
-
-					for (int32_t y = starty; y <= endy; ++y) {
-						for (int32_t x = mapWalkWidth - 1; --x >= 0;) {
-							localMapCache[y][x + 1] = localMapCache[y][x];
-						}
-					}
-
-					// update 0
-					for (int32_t y = -maxWalkCacheHeight; y <= maxWalkCacheHeight; ++y) {
-						Tile* cacheTile = g_game.map.getTile(myPos.x - maxWalkCacheWidth, myPos.y + y, myPos.z);
-						updateTileCache(cacheTile, -maxWalkCacheWidth, y);
-					}
+				if (stepX != 0) {
+					updateMapCacheColumn(stepX < 0 ? -maxWalkCacheWidth : maxWalkCacheWidth);
 				}
 
 				updateTileCache(oldTile, oldPos);
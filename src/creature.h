@@ -57,6 +57,59 @@ inline constexpr int32_t EVENT_CREATURECOUNT = 10;
 inline constexpr int32_t EVENT_CREATURE_THINK_INTERVAL = 250;
 inline constexpr int32_t EVENT_CHECK_CREATURE_INTERVAL = (EVENT_CREATURE_THINK_INTERVAL / EVENT_CREATURECOUNT);
 
+// Walkability of the tiles around a creature, one bit per tile packed into one word per row.
+class WalkCache
+{
+public:
+	static constexpr int32_t width = Map::maxViewportX * 2 + 1;
+	static constexpr int32_t height = Map::maxViewportY * 2 + 1;
+	static constexpr int32_t maxOffsetX = (width - 1) / 2;
+	static constexpr int32_t maxOffsetY = (height - 1) / 2;
+
+	bool test(int32_t dx, int32_t dy) const { return (rows[maxOffsetY + dy] >> (maxOffsetX + dx)) & 1; }
+
+	void set(int32_t dx, int32_t dy, bool walkable)
+	{
+		const uint32_t bit = static_cast<uint32_t>(1) << (maxOffsetX + dx);
+		if (walkable) {
+			rows[maxOffsetY + dy] |= bit;
+		} else {
+			rows[maxOffsetY + dy] &= ~bit;
+		}
+	}
+
+	void clear() { rows.fill(0); }
+
+	// Moves the window along with a one tile step of its owner, the row and column
+	// entering the window are left unwalkable until they are refreshed.
+	void shift(int32_t stepX, int32_t stepY)
+	{
+		if (stepY < 0) {
+			std::copy_backward(rows.begin(), rows.end() - 1, rows.end());
+			rows.front() = 0;
+		} else if (stepY > 0) {
+			std::copy(rows.begin() + 1, rows.end(), rows.begin());
+			rows.back() = 0;
+		}
+
+		if (stepX > 0) {
+			for (uint32_t& row : rows) {
+				row >>= 1;
+			}
+		} else if (stepX < 0) {
+			for (uint32_t& row : rows) {
+				row = (row << 1) & rowMask;
+			}
+		}
+	}
+
+private:
+	static_assert(width < 32, "WalkCache rows must fit in a single word");
+	static constexpr uint32_t rowMask = (static_cast<uint32_t>(1) << width) - 1;
+
+	std::array<uint32_t, height> rows = {};
+};
+
 class FrozenPathingConditionCall
 {
 public:
@@ -362,10 +415,8 @@ protected:
 		int64_t ticks;
 	};
 
-	static constexpr int32_t mapWalkWidth = Map::maxViewportX * 2 + 1;
-	static constexpr int32_t mapWalkHeight = Map::maxViewportY * 2 + 1;
-	static constexpr int32_t maxWalkCacheWidth = (mapWalkWidth - 1) / 2;
-	static constexpr int32_t maxWalkCacheHeight = (mapWalkHeight - 1) / 2;
+	static constexpr int32_t maxWalkCacheWidth = WalkCache::maxOffsetX;
+	static constexpr int32_t maxWalkCacheHeight = WalkCache::maxOffsetY;
 
 	Position position;
 
@@ -409,7 +460,7 @@ protected:
 	Direction direction = DIRECTION_SOUTH;
 	Skulls_t skull = SKULL_NONE;
 
-	bool localMapCache[mapWalkHeight][mapWalkWidth] = {{false}};
+	WalkCache localMapCache;
 	bool isInternalRemoved = false;
 	bool isMapLoaded = false;
 	bool isUpdatingPath = false;
@@ -433,6 +484,8 @@ protected:
 	void updateMapCache();
 	void updateTileCache(const Tile* tile, int32_t dx, int32_t dy);
 	void updateTileCache(const Tile* tile, const Position& pos);
+	void updateMapCacheRow(int32_t dy);
+	void updateMapCacheColumn(int32_t dx);
 	void onCreatureDisappear(const Creature* creature, bool isLogout);
 	virtual void doAttacking(uint32_t) {}
 	virtual bool hasExtraSwing() { return false; }
@@ -451,7 +504,7 @@ protected:
 	friend class LuaScriptInterface;
 
 private:
-	std::map<uint32_t, int64_t> storageMap;
+	std::unordered_map<uint32_t, int64_t> storageMap;
 };
 
 #endif
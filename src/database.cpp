@@ -119,13 +119,55 @@ bool Database::executeQuery(std::string_view query)
 	return success;
 }
 
+bool Database::executeQuery(std::string_view query, const std::vector<std::string_view>& blobs)
+{
+	std::lock_guard<std::recursive_mutex> lockGuard(databaseLock);
+
+	MYSQL_STMT* stmt = mysql_stmt_init(handle);
+	if (!stmt) {
+		std::cout << "[Error - mysql_stmt_init] Message: " << mysql_error(handle) << std::endl;
+		return false;
+	}
+
+	std::vector<unsigned long> lengths(blobs.size());
+	std::vector<MYSQL_BIND> binds(blobs.size());
+	for (size_t i = 0; i < blobs.size(); ++i) {
+		lengths[i] = blobs[i].size();
+
+		MYSQL_BIND& bind = binds[i];
+		std::memset(&bind, 0, sizeof(MYSQL_BIND));
+		bind.buffer_type = MYSQL_TYPE_BLOB;
+		bind.buffer = const_cast<char*>(blobs[i].data());
+		bind.buffer_length = lengths[i];
+		bind.length = &lengths[i];
+	}
+
+	const bool success = mysql_stmt_prepare(stmt, query.data(), query.length()) == 0 &&
+	                     !mysql_stmt_bind_param(stmt, binds.data()) && mysql_stmt_execute(stmt) == 0;
+	if (!success) {
+		std::cout << "[Error - mysql_stmt_execute] Query: " << query.substr(0, 256) << std::endl
+		          << "Message: " << mysql_stmt_error(stmt) << std::endl;
+	}
+
+	mysql_stmt_close(stmt);
+	return success;
+}
+
 DBResult_ptr Database::storeQuery(std::string_view query)
+{
+	DBResult_ptr result;
+	storeQuery(query, result);
+	return result;
+}
+
+bool Database::storeQuery(std::string_view query, DBResult_ptr& result)
 {
 	std::lock_guard<std::recursive_mutex> lockGuard(databaseLock);
+	result = nullptr;
 
 retry:
 	if (!::executeQuery(handle, query, retryQueries) && !retryQueries) {
-		return nullptr;
+		return false;
 	}
 
 	// we should call that every time as someone would call executeQuery('SELECT...')
@@ -136,17 +178,17 @@ retry:
 		          << "Message: " << mysql_error(handle) << std::endl;
 		const unsigned error = mysql_errno(handle);
 		if (!isLostConnectionError(error) || !retryQueries) {
-			return nullptr;
+			return false;
 		}
 		goto retry;
 	}
 
 	// retrieving results of query
-	DBResult_ptr result = std::make_shared<DBResult>(res);
+	result = std::make_shared<DBResult>(res);
 	if (!result->hasNext()) {
-		return nullptr;
+		result = nullptr;
 	}
-	return result;
+	return true;
 }
 
 std::string Database::escapeString(std::string_view s) const { return escapeBlob(s.data(), s.length()); }
@@ -180,6 +222,7 @@ DBResult::DBResult(MYSQL_RES* res)
 	MYSQL_FIELD* field = mysql_fetch_field(handle);
 	while (field) {
 		listNames[field->name] = i++;
+		numericColumns.push_back(IS_NUM(field->type));
 		field = mysql_fetch_field(handle);
 	}
 
@@ -232,24 +275,29 @@ bool DBResult::next()
 	return row != nullptr;
 }
 
-DBInsert::DBInsert(std::string_view query) : query{query} { this->length = this->query.length(); }
+DBInsert::DBInsert(std::string_view query, std::string_view suffix, Database& db) :
+    db{db}, query{query}, suffix{suffix}
+{
+	this->length = this->query.length() + this->suffix.length();
+}
 
 bool DBInsert::addRow(std::string_view row)
 {
-	// adds new row to buffer
-	const size_t rowLength = row.length();
-	length += rowLength;
-	if (length > Database::getInstance().getMaxPacketSize() && !execute()) {
+	// adds new row to buffer, flushing the buffered rows first if the statement would grow past the packet size
+	const size_t rowLength = row.length() + 3;
+	if (length + rowLength > db.getMaxPacketSize() && !execute()) {
 		return false;
 	}
+	length += rowLength;
+	++rowCount;
 
 	if (values.empty()) {
-		values.reserve(rowLength + 2);
+		values.reserve(rowLength);
 		values.push_back('(');
 		values.append(row);
 		values.push_back(')');
 	} else {
-		values.reserve(values.length() + rowLength + 3);
+		values.reserve(values.length() + rowLength);
 		values.push_back(',');
 		values.push_back('(');
 		values.append(row);
@@ -272,8 +320,60 @@ bool DBInsert::execute()
 	}
 
 	// executes buffer
-	bool res = Database::getInstance().executeQuery(query + values);
+	bool res = db.executeQuery(query + values + suffix);
+	values.clear();
+	length = query.length() + suffix.length();
+	return res;
+}
+
+DBBlobInsert::DBBlobInsert(std::string_view query) : query{query} { this->length = this->query.length(); }
+
+bool DBBlobInsert::addRow(std::string_view row, std::string_view blob)
+{
+	// the server takes at most 65535 placeholders per statement
+	const size_t rowLength = row.length() + blob.length() + 6;
+	if ((length + rowLength > Database::getInstance().getMaxPacketSize() ||
+	     blobEnds.size() == std::numeric_limits<uint16_t>::max()) &&
+	    !execute()) {
+		return false;
+	}
+	length += rowLength;
+	++rowCount;
+
+	if (!values.empty()) {
+		values.push_back(',');
+	}
+	values.push_back('(');
+	values.append(row);
+	values.append(", ?)");
+
+	blobData.append(blob);
+	blobEnds.push_back(blobData.size());
+	return true;
+}
+
+bool DBBlobInsert::execute()
+{
+	if (values.empty()) {
+		return true;
+	}
+
+	std::vector<std::string_view> blobs;
+	blobs.reserve(blobEnds.size());
+	size_t begin = 0;
+	for (size_t end : blobEnds) {
+		blobs.emplace_back(blobData.data() + begin, end - begin);
+		begin = end;
+	}
+
+	const std::string statement = query + values;
+	bytesSent += statement.size() + blobData.size();
+
+	// executes buffer
+	bool res = Database::getInstance().executeQuery(statement, blobs);
 	values.clear();
+	blobData.clear();
+	blobEnds.clear();
 	length = query.length();
 	return res;
 }
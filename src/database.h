@@ -48,6 +48,18 @@ public:
 	 */
 	bool executeQuery(std::string_view query);
 
+	/**
+	 * Executes command with binary parameters.
+	 *
+	 * Prepares the query and binds each blob to its ? placeholder, in order, so the data is sent as is instead of
+	 * being escaped into the query text.
+	 *
+	 * @param query command
+	 * @param blobs parameter values
+	 * @return true on success, false on error
+	 */
+	bool executeQuery(std::string_view query, const std::vector<std::string_view>& blobs);
+
 	/**
 	 * Queries database.
 	 *
@@ -57,6 +69,14 @@ public:
 	 */
 	DBResult_ptr storeQuery(std::string_view query);
 
+	/**
+	 * Queries database, telling a failed query apart from one without rows.
+	 *
+	 * @param result set to the rows, nullptr if there are none
+	 * @return false on error
+	 */
+	bool storeQuery(std::string_view query, DBResult_ptr& result);
+
 	/**
 	 * Escapes string for query.
 	 *
@@ -154,11 +174,15 @@ public:
 	bool hasNext() const;
 	bool next();
 
+	const std::map<std::string_view, size_t>& getColumns() const { return listNames; }
+	bool isNumeric(size_t column) const { return numericColumns[column]; }
+
 private:
 	MYSQL_RES* handle;
 	MYSQL_ROW row;
 
 	std::map<std::string_view, size_t> listNames;
+	std::vector<bool> numericColumns;
 
 	friend class Database;
 };
@@ -169,26 +193,58 @@ private:
 class DBInsert
 {
 public:
-	explicit DBInsert(std::string_view query);
+	// suffix follows the rows of every statement, such as an ON DUPLICATE KEY UPDATE clause
+	explicit DBInsert(std::string_view query, std::string_view suffix = {}, Database& db = Database::getInstance());
 	bool addRow(std::string_view row);
 	bool addRow(std::ostringstream& row);
 	bool execute();
 
+	// rows added so far, executed or not
+	size_t getRowCount() const { return rowCount; }
+
+private:
+	Database& db;
+	std::string query;
+	std::string suffix;
+	std::string values;
+	size_t length;
+	size_t rowCount = 0;
+};
+
+// Batched INSERT whose last column is binary. The blobs are sent as bound parameters of a prepared statement, other
+// columns are plain numbers written into the query text.
+class DBBlobInsert
+{
+public:
+	explicit DBBlobInsert(std::string_view query);
+	// row holds every column but the blob
+	bool addRow(std::string_view row, std::string_view blob);
+	bool execute();
+
+	size_t getRowCount() const { return rowCount; }
+	// query text and blob bytes handed to the server so far
+	uint64_t getBytesSent() const { return bytesSent; }
+
 private:
 	std::string query;
 	std::string values;
+	// every buffered blob, back to back
+	std::string blobData;
+	std::vector<size_t> blobEnds;
 	size_t length;
+	size_t rowCount = 0;
+	uint64_t bytesSent = 0;
 };
 
 class DBTransaction
 {
 public:
-	constexpr DBTransaction() = default;
+	explicit DBTransaction(Database& db = Database::getInstance()) : db(db) {}
 
 	~DBTransaction()
 	{
 		if (state == STATE_START) {
-			Database::getInstance().rollback();
+			db.rollback();
 		}
 	}
 
@@ -199,7 +255,7 @@ public:
 	bool begin()
 	{
 		state = STATE_START;
-		return Database::getInstance().beginTransaction();
+		return db.beginTransaction();
 	}
 
 	bool commit()
@@ -209,7 +265,7 @@ public:
 		}
 
 		state = STATE_COMMIT;
-		return Database::getInstance().commit();
+		return db.commit();
 	}
 
 private:
@@ -220,6 +276,7 @@ private:
 		STATE_COMMIT,
 	};
 
+	Database& db;
 	TransactionStates_t state = STATE_NO_START;
 };
 
@@ -51,13 +51,32 @@ void DatabaseTasks::addTask(std::string query, std::function<void(DBResult_ptr,
 	}
 }
 
+void DatabaseTasks::addJob(std::function<void(Database&)> job)
+{
+	bool signal = false;
+	taskLock.lock();
+	if (getState() == THREAD_STATE_RUNNING) {
+		signal = tasks.empty();
+		tasks.emplace_back(std::move(job));
+	}
+	taskLock.unlock();
+
+	if (signal) {
+		taskSignal.notify_one();
+	}
+}
+
 void DatabaseTasks::runTask(const DatabaseTask& task)
 {
+	if (task.job) {
+		task.job(db);
+		return;
+	}
+
 	bool success;
 	DBResult_ptr result;
 	if (task.store) {
-		result = db.storeQuery(task.query);
-		success = true;
+		success = db.storeQuery(task.query, result);
 	} else {
 		result = nullptr;
 		success = db.executeQuery(task.query);
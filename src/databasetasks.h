@@ -15,10 +15,12 @@ struct DatabaseTask
 	DatabaseTask(std::string_view query, std::function<void(DBResult_ptr, bool)>&& callback, bool store) :
 	    query{query}, callback{std::move(callback)}, store{store}
 	{}
+	explicit DatabaseTask(std::function<void(Database&)>&& job) : job{std::move(job)} {}
 
 	std::string query;
 	std::function<void(DBResult_ptr, bool)> callback;
-	bool store;
+	std::function<void(Database&)> job;
+	bool store = false;
 };
 
 class DatabaseTasks : public ThreadHolder<DatabaseTasks>
@@ -30,6 +32,8 @@ public:
 	void shutdown();
 
 	void addTask(std::string query, std::function<void(DBResult_ptr, bool)> callback = nullptr, bool store = false);
+	// runs a sequence of queries on the worker connection, the job hands its results back to the dispatcher itself
+	void addJob(std::function<void(Database&)> job);
 
 	void threadMain();
 
@@ -137,6 +137,9 @@ public:
 		std::copy(str.begin(), str.end(), std::back_inserter(buffer));
 	}
 
+	// appends bytes as they are, without a length
+	void writeBytes(std::string_view bytes) { buffer.insert(buffer.end(), bytes.begin(), bytes.end()); }
+
 private:
 	std::vector<char> buffer;
 };
@@ -17,6 +17,7 @@
 #include "items.h"
 #include "monster.h"
 #include "movement.h"
+#include "protocolstatus.h"
 #include "pugicast.h"
 #include "scheduler.h"
 #include "script.h"
@@ -38,6 +39,43 @@ extern MoveEvents* g_moveEvents;
 extern Weapons* g_weapons;
 extern Scripts* g_scripts;
 
+namespace {
+
+template <typename T>
+bool eraseMappedName(std::unordered_multimap<std::string, T*>& mappedNames, const std::string& lowerCaseName,
+                     T* creature)
+{
+	auto range = mappedNames.equal_range(lowerCaseName);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second == creature) {
+			mappedNames.erase(it);
+			return true;
+		}
+	}
+	return false;
+}
+
+template <typename T>
+T* findMappedName(const std::unordered_multimap<std::string, T*>& mappedNames, const std::string& lowerCaseName)
+{
+	auto it = mappedNames.find(lowerCaseName);
+	if (it == mappedNames.end()) {
+		return nullptr;
+	}
+	return it->second;
+}
+
+template <typename T>
+void updateMappedName(std::unordered_multimap<std::string, T*>& mappedNames, const std::string& oldName, T* creature)
+{
+	// creatures that are not in the game yet are indexed once they are added
+	if (eraseMappedName(mappedNames, boost::algorithm::to_lower_copy(oldName), creature)) {
+		mappedNames.emplace(boost::algorithm::to_lower_copy(creature->getName()), creature);
+	}
+}
+
+} // namespace
+
 Game::~Game()
 {
 	for (const auto& it : guilds) {
@@ -50,6 +88,7 @@ void Game::start(ServiceManager* manager)
 	serviceManager = manager;
 	g_scheduler.addEvent(createSchedulerTask(EVENT_CREATURE_THINK_INTERVAL, [this]() { checkCreatures(0); }));
 	g_scheduler.addEvent(createSchedulerTask(EVENT_DECAYINTERVAL, [this]() { checkDecay(); }));
+	IOLoginData::scheduleStorageFlush();
 }
 
 GameState_t Game::getGameState() const { return gameState; }
@@ -374,28 +413,10 @@ Creature* Game::getCreatureByName(const std::string& s)
 		}
 	}
 
-	auto equalCreatureName = [&](const std::pair<uint32_t, Creature*>& it) {
-		auto& name = it.second->getName();
-		return lowerCaseName.size() == name.size() &&
-		       std::equal(lowerCaseName.begin(), lowerCaseName.end(), name.begin(),
-		                  [](char a, char b) { return a == std::tolower(b); });
-	};
-
-	{
-		auto it = std::find_if(npcs.begin(), npcs.end(), equalCreatureName);
-		if (it != npcs.end()) {
-			return it->second;
-		}
+	if (Npc* npc = findMappedName(mappedNpcNames, lowerCaseName)) {
+		return npc;
 	}
-
-	{
-		auto it = std::find_if(monsters.begin(), monsters.end(), equalCreatureName);
-		if (it != monsters.end()) {
-			return it->second;
-		}
-	}
-
-	return nullptr;
+	return findMappedName(mappedMonsterNames, lowerCaseName);
 }
 
 Npc* Game::getNpcByName(std::string_view npcName)
@@ -404,12 +425,7 @@ Npc* Game::getNpcByName(std::string_view npcName)
 		return nullptr;
 	}
 
-	for (const auto& it : npcs) {
-		if (caseInsensitiveEqual(npcName, it.second->getName())) {
-			return it.second;
-		}
-	}
-	return nullptr;
+	return findMappedName(mappedNpcNames, boost::algorithm::to_lower_copy(std::string{npcName}));
 }
 
 Player* Game::getPlayerByName(std::string_view s)
@@ -3728,11 +3744,15 @@ bool Game::internalCreatureSay(Creature* creature, SpeakClasses type, std::strin
 		spectators = (*spectatorsPtr);
 	}
 
-	// send to client
+	// send to client, the packet is the same for every spectator so it is encoded on first use only
+	NetworkMessage msg;
 	for (Creature* spectator : spectators) {
 		if (Player* tmpPlayer = spectator->getPlayer()) {
 			if (!ghostMode || tmpPlayer->canSeeCreature(creature)) {
-				tmpPlayer->sendCreatureSay(creature, type, text, pos);
+				if (msg.getLength() == 0) {
+					ProtocolGame::AddCreatureSay(msg, creature, type, text, pos);
+				}
+				tmpPlayer->sendNetworkMessage(msg);
 			}
 		}
 	}
@@ -4510,9 +4530,11 @@ void Game::addCreatureHealth(const Creature* target)
 
 void Game::addCreatureHealth(const SpectatorVec& spectators, const Creature* target)
 {
+	NetworkMessage msg;
+	ProtocolGame::AddCreatureHealth(msg, target);
 	for (Creature* spectator : spectators) {
 		assert(dynamic_cast<Player*>(spectator) != nullptr);
-		static_cast<Player*>(spectator)->sendCreatureHealth(target);
+		static_cast<Player*>(spectator)->sendNetworkMessage(msg);
 	}
 }
 
@@ -4530,9 +4552,11 @@ void Game::addAnimatedText(std::string_view message, const Position& pos, TextCo
 void Game::addAnimatedText(const SpectatorVec& spectators, std::string_view message, const Position& pos,
                            TextColor_t color)
 {
+	NetworkMessage msg;
+	ProtocolGame::AddAnimatedText(msg, message, pos, color);
 	for (Creature* spectator : spectators) {
 		assert(dynamic_cast<Player*>(spectator) != nullptr);
-		static_cast<Player*>(spectator)->sendAnimatedText(message, pos, color);
+		static_cast<Player*>(spectator)->sendNetworkMessage(pos, msg);
 	}
 }
 
@@ -4545,9 +4569,11 @@ void Game::addMagicEffect(const Position& pos, uint8_t effect)
 
 void Game::addMagicEffect(const SpectatorVec& spectators, const Position& pos, uint8_t effect)
 {
+	NetworkMessage msg;
+	ProtocolGame::AddMagicEffect(msg, pos, effect);
 	for (Creature* spectator : spectators) {
 		assert(dynamic_cast<Player*>(spectator) != nullptr);
-		static_cast<Player*>(spectator)->sendMagicEffect(pos, effect);
+		static_cast<Player*>(spectator)->sendNetworkMessage(pos, msg);
 	}
 }
 
@@ -4564,14 +4590,18 @@ void Game::addDistanceEffect(const Position& fromPos, const Position& toPos, uin
 void Game::addDistanceEffect(const SpectatorVec& spectators, const Position& fromPos, const Position& toPos,
                              uint8_t effect)
 {
+	NetworkMessage msg;
+	ProtocolGame::AddDistanceShoot(msg, fromPos, toPos, effect);
 	for (Creature* spectator : spectators) {
 		assert(dynamic_cast<Player*>(spectator) != nullptr);
-		static_cast<Player*>(spectator)->sendDistanceShoot(fromPos, toPos, effect);
+		static_cast<Player*>(spectator)->sendNetworkMessage(msg);
 	}
 }
 
 void Game::setAccountStorageValue(const uint32_t accountId, const uint32_t key, const int32_t value)
 {
+	changedAccountStorageKeys.emplace(accountId, key);
+
 	if (value == -1) {
 		accountStorageMap[accountId].erase(key);
 		return;
@@ -4603,40 +4633,44 @@ void Game::loadAccountStorageValues()
 			                              result->getNumber<int32_t>("value"));
 		} while (result->next());
 	}
+	changedAccountStorageKeys.clear();
 }
 
-bool Game::saveAccountStorageValues() const
+bool Game::saveAccountStorageValues()
 {
-	DBTransaction transaction;
-	Database& db = Database::getInstance();
-
-	if (!transaction.begin()) {
-		return false;
+	int64_t start = OTSYS_TIME();
+	if (changedAccountStorageKeys.empty()) {
+		return true;
 	}
 
-	if (!db.executeQuery("DELETE FROM `account_storage`")) {
+	DBTransaction transaction;
+	if (!transaction.begin()) {
 		return false;
 	}
 
-	for (const auto& accountIt : g_game.accountStorageMap) {
-		if (accountIt.second.empty()) {
-			break;
-		}
-
-		DBInsert accountStorageQuery("INSERT INTO `account_storage` (`account_id`, `key`, `value`) VALUES");
-		for (const auto& storageIt : accountIt.second) {
-			if (!accountStorageQuery.addRow(
-			        fmt::format("{:d}, {:d}, {:d}", accountIt.first, storageIt.first, storageIt.second))) {
+	DBInsert upsertQuery("INSERT INTO `account_storage` (`account_id`, `key`, `value`) VALUES ",
+	                     " ON DUPLICATE KEY UPDATE `value` = VALUES(`value`)");
+	DBInsert deleteQuery("DELETE FROM `account_storage` WHERE (`account_id`, `key`) IN (", ")");
+	for (const auto& [accountId, key] : changedAccountStorageKeys) {
+		int32_t value = getAccountStorageValue(accountId, key);
+		if (value != -1) {
+			if (!upsertQuery.addRow(fmt::format("{:d}, {:d}, {:d}", accountId, key, value))) {
 				return false;
 			}
-		}
-
-		if (!accountStorageQuery.execute()) {
+		} else if (!deleteQuery.addRow(fmt::format("{:d}, {:d}", accountId, key))) {
 			return false;
 		}
 	}
 
-	return transaction.commit();
+	if (!upsertQuery.execute() || !deleteQuery.execute() || !transaction.commit()) {
+		return false;
+	}
+
+	changedAccountStorageKeys.clear();
+	std::cout << "> Saved account storage values in: " << (OTSYS_TIME() - start) / (1000.) << " s ("
+	          << upsertQuery.getRowCount() << " rows written, " << deleteQuery.getRowCount() << " removed)"
+	          << std::endl;
+	return true;
 }
 
 void Game::startDecay(Item* item)
@@ -4873,6 +4907,13 @@ void Game::updatePlayersRecord() const
 	    fmt::format("UPDATE `server_config` SET `value` = '{:d}' WHERE `config` = 'players_record'", playersRecord));
 }
 
+void Game::addLoginTime(int64_t microseconds)
+{
+	auto it = std::upper_bound(LOGIN_TIME_LIMITS.begin(), LOGIN_TIME_LIMITS.end(), microseconds / 1000);
+	++loginStatistics.dispatcherTime[std::distance(LOGIN_TIME_LIMITS.begin(), it)];
+	++loginStatistics.logins;
+}
+
 void Game::loadPlayersRecord()
 {
 	Database& db = Database::getInstance();
@@ -5132,6 +5173,7 @@ void Game::addPlayer(Player* player)
 	mappedPlayerGuids[player->getGUID()] = player;
 	wildcardTree.insert(lowercase_name);
 	players[player->getID()] = player;
+	ProtocolStatus::invalidateStatusSnapshot();
 }
 
 void Game::removePlayer(Player* player)
@@ -5141,15 +5183,39 @@ void Game::removePlayer(Player* player)
 	mappedPlayerGuids.erase(player->getGUID());
 	wildcardTree.remove(lowercase_name);
 	players.erase(player->getID());
+	ProtocolStatus::invalidateStatusSnapshot();
 }
 
-void Game::addNpc(Npc* npc) { npcs[npc->getID()] = npc; }
+void Game::addNpc(Npc* npc)
+{
+	npcs[npc->getID()] = npc;
+	mappedNpcNames.emplace(boost::algorithm::to_lower_copy(npc->getName()), npc);
+}
 
-void Game::removeNpc(Npc* npc) { npcs.erase(npc->getID()); }
+void Game::removeNpc(Npc* npc)
+{
+	npcs.erase(npc->getID());
+	eraseMappedName(mappedNpcNames, boost::algorithm::to_lower_copy(npc->getName()), npc);
+}
 
-void Game::addMonster(Monster* monster) { monsters[monster->getID()] = monster; }
+void Game::updateNpcName(Npc* npc, const std::string& oldName) { updateMappedName(mappedNpcNames, oldName, npc); }
 
-void Game::removeMonster(Monster* monster) { monsters.erase(monster->getID()); }
+void Game::addMonster(Monster* monster)
+{
+	monsters[monster->getID()] = monster;
+	mappedMonsterNames.emplace(boost::algorithm::to_lower_copy(monster->getName()), monster);
+}
+
+void Game::removeMonster(Monster* monster)
+{
+	monsters.erase(monster->getID());
+	eraseMappedName(mappedMonsterNames, boost::algorithm::to_lower_copy(monster->getName()), monster);
+}
+
+void Game::updateMonsterName(Monster* monster, const std::string& oldName)
+{
+	updateMappedName(mappedMonsterNames, oldName, monster);
+}
 
 Guild* Game::getGuild(uint32_t id) const
 {
@@ -5160,9 +5226,34 @@ Guild* Game::getGuild(uint32_t id) const
 	return it->second;
 }
 
-void Game::addGuild(Guild* guild) { guilds[guild->getId()] = guild; }
+Guild* Game::getGuildByName(std::string_view name) const
+{
+	auto it = mappedGuildNames.find(boost::algorithm::to_lower_copy(std::string{name}));
+	if (it == mappedGuildNames.end()) {
+		return nullptr;
+	}
+	return it->second;
+}
+
+void Game::addGuild(Guild* guild)
+{
+	guilds[guild->getId()] = guild;
+	mappedGuildNames[boost::algorithm::to_lower_copy(guild->getName())] = guild;
+}
 
-void Game::removeGuild(uint32_t guildId) { guilds.erase(guildId); }
+void Game::removeGuild(uint32_t guildId)
+{
+	auto it = guilds.find(guildId);
+	if (it == guilds.end()) {
+		return;
+	}
+
+	auto nameIt = mappedGuildNames.find(boost::algorithm::to_lower_copy(it->second->getName()));
+	if (nameIt != mappedGuildNames.end() && nameIt->second == it->second) {
+		mappedGuildNames.erase(nameIt);
+	}
+	guilds.erase(it);
+}
 
 void Game::internalRemoveItems(std::vector<Item*> itemList, uint32_t amount, bool stackable)
 {
@@ -5354,37 +5445,50 @@ void Game::loadGameStorageValues()
 			g_game.setStorageValue(result->getNumber<uint32_t>("key"), result->getNumber<int32_t>("value"));
 		} while (result->next());
 	}
+	changedStorageKeys.clear();
 }
 
-bool Game::saveGameStorageValues() const
+bool Game::saveGameStorageValues()
 {
-	DBTransaction transaction;
-	Database& db = Database::getInstance();
-
-	if (!transaction.begin()) {
-		return false;
+	int64_t start = OTSYS_TIME();
+	if (changedStorageKeys.empty()) {
+		return true;
 	}
 
-	if (!db.executeQuery("DELETE FROM `game_storage`")) {
+	DBTransaction transaction;
+	if (!transaction.begin()) {
 		return false;
 	}
 
-	for (const auto& [key, value] : g_game.storageMap) {
-		DBInsert gameStorageQuery("INSERT INTO `game_storage` (`key`, `value`) VALUES");
-		if (!gameStorageQuery.addRow(fmt::format("{:d}, {:d}", key, value))) {
+	DBInsert upsertQuery("INSERT INTO `game_storage` (`key`, `value`) VALUES ",
+	                     " ON DUPLICATE KEY UPDATE `value` = VALUES(`value`)");
+	DBInsert deleteQuery("DELETE FROM `game_storage` WHERE `key` IN (", ")");
+	for (uint32_t key : changedStorageKeys) {
+		auto it = storageMap.find(key);
+		if (it != storageMap.end()) {
+			if (!upsertQuery.addRow(fmt::format("{:d}, {:d}", key, it->second))) {
+				return false;
+			}
+		} else if (!deleteQuery.addRow(std::to_string(key))) {
 			return false;
 		}
+	}
 
-		if (!gameStorageQuery.execute()) {
-			return false;
-		}
+	if (!upsertQuery.execute() || !deleteQuery.execute() || !transaction.commit()) {
+		return false;
 	}
 
-	return transaction.commit();
+	changedStorageKeys.clear();
+	std::cout << "> Saved game storage values in: " << (OTSYS_TIME() - start) / (1000.) << " s ("
+	          << upsertQuery.getRowCount() << " rows written, " << deleteQuery.getRowCount() << " removed)"
+	          << std::endl;
+	return true;
 }
 
 void Game::setStorageValue(uint32_t key, std::optional<int64_t> value)
 {
+	changedStorageKeys.insert(key);
+
 	if (value) {
 		storageMap.insert_or_assign(key, value.value());
 	} else {
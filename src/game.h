@@ -68,6 +68,16 @@ inline constexpr int32_t RANGE_BROWSE_FIELD_INTERVAL = 400;
 inline constexpr int32_t RANGE_WRAP_ITEM_INTERVAL = 400;
 inline constexpr int32_t RANGE_REQUEST_TRADE_INTERVAL = 400;
 
+// how long logins keep the dispatcher busy; bucket i counts logins that took less than LOGIN_TIME_LIMITS[i]
+// milliseconds, the last bucket everything slower
+inline constexpr std::array<uint32_t, 7> LOGIN_TIME_LIMITS = {1, 2, 5, 10, 25, 50, 100};
+
+struct LoginStatistics
+{
+	std::array<uint64_t, LOGIN_TIME_LIMITS.size() + 1> dispatcherTime = {};
+	uint64_t logins = 0;
+};
+
 /**
  * Main Game class.
  * This class is responsible to control everything that happens
@@ -217,6 +227,9 @@ public:
 	size_t getNpcsOnline() const { return npcs.size(); }
 	uint32_t getPlayersRecord() const { return playersRecord; }
 
+	void addLoginTime(int64_t microseconds);
+	const LoginStatistics& getLoginStatistics() const { return loginStatistics; }
+
 	ReturnValue internalMoveCreature(Creature* creature, Direction direction, uint32_t flags = 0);
 	ReturnValue internalMoveCreature(Creature& creature, Tile& toTile, uint32_t flags = 0);
 
@@ -436,7 +449,7 @@ public:
 	void setAccountStorageValue(const uint32_t accountId, const uint32_t key, const int32_t value);
 	int32_t getAccountStorageValue(const uint32_t accountId, const uint32_t key) const;
 	void loadAccountStorageValues();
-	bool saveAccountStorageValues() const;
+	bool saveAccountStorageValues();
 
 	void startDecay(Item* item);
 
@@ -448,17 +461,22 @@ public:
 
 	const std::unordered_map<uint32_t, Player*>& getPlayers() const { return players; }
 	const std::map<uint32_t, Npc*>& getNpcs() const { return npcs; }
+	const std::map<uint32_t, Monster*>& getMonsters() const { return monsters; }
 
 	void addPlayer(Player* player);
 	void removePlayer(Player* player);
 
 	void addNpc(Npc* npc);
 	void removeNpc(Npc* npc);
+	void updateNpcName(Npc* npc, const std::string& oldName);
 
 	void addMonster(Monster* monster);
 	void removeMonster(Monster* monster);
+	void updateMonsterName(Monster* monster, const std::string& oldName);
 
 	Guild* getGuild(uint32_t id) const;
+	Guild* getGuildByName(std::string_view name) const;
+	const std::unordered_map<uint32_t, Guild*>& getGuilds() const { return guilds; }
 	void addGuild(Guild* guild);
 	void removeGuild(uint32_t guildId);
 
@@ -487,7 +505,7 @@ public:
 	void clearTilesToClean() { tilesToClean.clear(); }
 
 	void loadGameStorageValues();
-	bool saveGameStorageValues() const;
+	bool saveGameStorageValues();
 
 	void setStorageValue(uint32_t key, std::optional<int64_t> value);
 	std::optional<int64_t> getStorageValue(uint32_t key) const;
@@ -495,6 +513,8 @@ public:
 
 private:
 	std::map<uint32_t, int64_t> storageMap;
+	// keys set or removed since the last save
+	std::set<uint32_t> changedStorageKeys;
 
 	bool playerSaySpell(Player* player, SpeakClasses type, std::string_view text);
 	void playerWhisper(Player* player, std::string_view text);
@@ -509,9 +529,11 @@ private:
 	std::unordered_map<std::string, Player*> mappedPlayerNames;
 	std::unordered_map<uint32_t, Player*> mappedPlayerGuids;
 	std::unordered_map<uint32_t, Guild*> guilds;
+	std::unordered_map<std::string, Guild*> mappedGuildNames;
 	std::unordered_map<uint16_t, Item*> uniqueItems;
 	std::map<uint32_t, uint32_t> stages;
 	std::unordered_map<uint32_t, std::unordered_map<uint32_t, int32_t>> accountStorageMap;
+	std::set<std::pair<uint32_t, uint32_t>> changedAccountStorageKeys; // account id, key
 
 	std::list<Item*> decayItems[EVENT_DECAY_BUCKETS];
 	std::list<Creature*> checkCreatureLists[EVENT_CREATURECOUNT];
@@ -526,6 +548,10 @@ private:
 	std::map<uint32_t, Npc*> npcs;
 	std::map<uint32_t, Monster*> monsters;
 
+	// lowercase names of the npcs and monsters above, several of them may share a name
+	std::unordered_multimap<std::string, Npc*> mappedNpcNames;
+	std::unordered_multimap<std::string, Monster*> mappedMonsterNames;
+
 	// list of items that are in trading state, mapped to the player
 	std::map<Item*, uint32_t> tradeItems;
 
@@ -540,6 +566,7 @@ private:
 
 	void updatePlayersRecord() const;
 	uint32_t playersRecord = 0;
+	LoginStatistics loginStatistics;
 
 	std::string motdHash;
 	uint32_t motdNum = 0;
@@ -5,20 +5,113 @@
 
 #include "guild.h"
 
+#include "configmanager.h"
+#include "databasetasks.h"
 #include "game.h"
+#include "scheduler.h"
 
 extern Game g_game;
+extern Dispatcher g_dispatcher;
+extern Scheduler g_scheduler;
+
+namespace {
+
+struct GuildRow
+{
+	uint32_t id;
+	std::string name;
+	uint32_t memberCount;
+	std::vector<GuildRank> ranks;
+};
+
+GuildStatistics guildStatistics;
+
+std::vector<GuildRow> fetchGuilds(Database& db)
+{
+	std::vector<GuildRow> rows;
+	std::unordered_map<uint32_t, size_t> rowIndex;
+
+	DBResult_ptr result = db.storeQuery(
+	    "SELECT `g`.`id`, `g`.`name`, (SELECT COUNT(*) FROM `guild_membership` AS `m` WHERE `m`.`guild_id` = `g`.`id`) AS `members` FROM `guilds` AS `g`");
+	if (!result) {
+		return rows;
+	}
+
+	do {
+		const uint32_t id = result->getNumber<uint32_t>("id");
+		rowIndex[id] = rows.size();
+		GuildRow& row = rows.emplace_back();
+		row.id = id;
+		row.name = result->getString("name");
+		row.memberCount = result->getNumber<uint32_t>("members");
+	} while (result->next());
+
+	if ((result = db.storeQuery("SELECT `id`, `guild_id`, `name`, `level` FROM `guild_ranks`"))) {
+		do {
+			auto it = rowIndex.find(result->getNumber<uint32_t>("guild_id"));
+			if (it != rowIndex.end()) {
+				rows[it->second].ranks.emplace_back(result->getNumber<uint32_t>("id"), result->getString("name"),
+				                                    static_cast<uint8_t>(result->getNumber<uint16_t>("level")));
+			}
+		} while (result->next());
+	}
+	return rows;
+}
+
+// updates cached guilds in place, since players hold pointers to them and their ranks. Ranks are never dropped,
+// scripts may have added some that are not stored.
+void applyGuilds(const std::vector<GuildRow>& rows)
+{
+	std::unordered_set<uint32_t> guildIds;
+	for (const GuildRow& row : rows) {
+		guildIds.insert(row.id);
+
+		Guild* guild = g_game.getGuild(row.id);
+		if (!guild) {
+			guild = new Guild(row.id, row.name);
+			g_game.addGuild(guild);
+		} else if (guild->getName() != row.name) {
+			g_game.removeGuild(row.id);
+			guild->setName(row.name);
+			g_game.addGuild(guild);
+		}
+
+		guild->setMemberCount(row.memberCount);
+		for (const GuildRank& rowRank : row.ranks) {
+			if (GuildRank_ptr rank = guild->getRankById(rowRank.id)) {
+				rank->name = rowRank.name;
+				rank->level = rowRank.level;
+			} else {
+				guild->addRank(rowRank.id, rowRank.name, rowRank.level);
+			}
+		}
+	}
+
+	// a failed query reads as no guilds at all, so nothing is dropped then
+	if (rows.empty()) {
+		return;
+	}
+
+	std::vector<Guild*> disbanded;
+	for (const auto& it : g_game.getGuilds()) {
+		if (!guildIds.contains(it.first) && it.second->getMembersOnline().empty()) {
+			disbanded.push_back(it.second);
+		}
+	}
+
+	for (Guild* guild : disbanded) {
+		g_game.removeGuild(guild->getId());
+		delete guild;
+	}
+}
+
+} // namespace
 
 void Guild::addMember(Player* player) { membersOnline.push_back(player); }
 
 void Guild::removeMember(Player* player)
 {
 	membersOnline.remove(player);
-
-	if (membersOnline.empty()) {
-		g_game.removeGuild(id);
-		delete this;
-	}
 }
 
 GuildRank_ptr Guild::getRankById(uint32_t rankId) const
@@ -85,3 +178,68 @@ uint32_t IOGuild::getGuildIdByName(std::string_view name)
 	}
 	return result->getNumber<uint32_t>("id");
 }
+
+void IOGuild::loadGuilds(Database& db)
+{
+	applyGuilds(fetchGuilds(db));
+}
+
+void IOGuild::reloadGuilds()
+{
+	const uint32_t interval = getInteger(ConfigManager::GUILD_REFRESH_INTERVAL);
+	if (interval == 0) {
+		return;
+	}
+
+	g_scheduler.addEvent(createSchedulerTask(interval, []() {
+		g_databaseTasks.addJob([](Database& db) {
+			g_dispatcher.addTask([rows = fetchGuilds(db)]() {
+				applyGuilds(rows);
+				++guildStatistics.reloads;
+				reloadGuilds();
+			});
+		});
+	}));
+}
+
+Guild* IOGuild::getGuild(uint32_t guildId)
+{
+	++guildStatistics.lookups;
+	if (Guild* guild = g_game.getGuild(guildId)) {
+		return guild;
+	}
+
+	// created since the last reload
+	++guildStatistics.misses;
+	Guild* guild = loadGuild(guildId);
+	if (guild) {
+		g_game.addGuild(guild);
+	}
+	return guild;
+}
+
+Guild* IOGuild::getGuildByName(std::string_view name)
+{
+	++guildStatistics.lookups;
+	if (Guild* guild = g_game.getGuildByName(name)) {
+		return guild;
+	}
+
+	++guildStatistics.misses;
+	uint32_t guildId = getGuildIdByName(name);
+	if (guildId == 0) {
+		return nullptr;
+	}
+
+	if (Guild* guild = g_game.getGuild(guildId)) {
+		return guild;
+	}
+
+	Guild* guild = loadGuild(guildId);
+	if (guild) {
+		g_game.addGuild(guild);
+	}
+	return guild;
+}
+
+const GuildStatistics& IOGuild::getStatistics() { return guildStatistics; }
@@ -4,6 +4,7 @@
 #ifndef FS_GUILD_H
 #define FS_GUILD_H
 
+class Database;
 class Player;
 
 struct GuildRank
@@ -27,6 +28,7 @@ public:
 
 	uint32_t getId() const { return id; }
 	const std::string& getName() const { return name; }
+	void setName(std::string_view name) { this->name = name; }
 	const std::list<Player*>& getMembersOnline() const { return membersOnline; }
 	uint32_t getMemberCount() const { return memberCount; }
 	void setMemberCount(uint32_t count) { memberCount = count; }
@@ -51,9 +53,27 @@ private:
 
 using GuildWarVector = std::vector<uint32_t>;
 
+// Guild lookups served by the cache since startup, misses fell back to querying the database
+struct GuildStatistics
+{
+	uint64_t lookups = 0;
+	uint64_t misses = 0;
+	uint64_t reloads = 0;
+};
+
 namespace IOGuild {
 Guild* loadGuild(uint32_t guildId);
 uint32_t getGuildIdByName(std::string_view name);
+
+// reads every guild and its ranks into the game's guild cache
+void loadGuilds(Database& db);
+// merges guilds created, renamed or disbanded outside the server into the cache each guildRefreshInterval
+void reloadGuilds();
+
+// the cached guild, loaded and cached on a miss
+Guild* getGuild(uint32_t guildId);
+Guild* getGuildByName(std::string_view name);
+const GuildStatistics& getStatistics();
 } // namespace IOGuild
 
 #endif
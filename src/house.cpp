@@ -7,8 +7,10 @@
 
 #include "bed.h"
 #include "configmanager.h"
+#include "databasetasks.h"
 #include "game.h"
 #include "iologindata.h"
+#include "protocolgame.h"
 #include "pugicast.h"
 
 extern Game g_game;
@@ -44,6 +46,14 @@ void House::setOwner(uint32_t guid, bool updateDatabase /* = true*/, Player* pla
 			transferToDepot();
 		}
 
+		// what could not be read of the stored items belonged to the previous owner
+		if (!unreadItems.empty()) {
+			std::cout << "[Warning - House::setOwner] Dropping " << unreadItems.size()
+			          << " bytes of unreadable stored items of house " << id << " with its previous owner."
+			          << std::endl;
+			unreadItems.clear();
+		}
+
 		for (HouseTile* tile : houseTiles) {
 			if (const CreatureVector* creatures = tile->getCreatures()) {
 				for (int32_t i = creatures->size(); --i >= 0;) {
@@ -427,28 +437,9 @@ void AccessList::addPlayer(std::string_view name)
 	}
 }
 
-namespace {
-
-const Guild* getGuildByName(std::string_view name)
-{
-	uint32_t guildId = IOGuild::getGuildIdByName(name);
-	if (guildId == 0) {
-		return nullptr;
-	}
-
-	const Guild* guild = g_game.getGuild(guildId);
-	if (guild) {
-		return guild;
-	}
-
-	return IOGuild::loadGuild(guildId);
-}
-
-} // namespace
-
 void AccessList::addGuild(std::string_view name)
 {
-	const Guild* guild = getGuildByName(name);
+	const Guild* guild = IOGuild::getGuildByName(name);
 	if (guild) {
 		for (GuildRank_ptr rank : guild->getRanks()) {
 			guildRankList.insert(rank->id);
@@ -458,7 +449,7 @@ void AccessList::addGuild(std::string_view name)
 
 void AccessList::addGuildRank(std::string_view name, std::string_view rankName)
 {
-	const Guild* guild = getGuildByName(name);
+	const Guild* guild = IOGuild::getGuildByName(name);
 	if (guild) {
 		GuildRank_ptr rank = guild->getRankByName(rankName);
 		if (rank) {
@@ -603,13 +594,214 @@ bool Houses::loadHousesXML(const std::string& filename)
 	return true;
 }
 
+namespace {
+
+enum class RentOutcome : uint8_t
+{
+	PAID,
+	WARNED,
+	EVICTED,
+	OWNER_MISSING,
+	// the house changed hands after the charge was planned, nothing was collected
+	OWNER_CHANGED,
+};
+
+struct RentCharge
+{
+	uint32_t houseId;
+	uint32_t ownerId;
+	uint32_t townId;
+	uint32_t rent;
+	bool canWarn;
+	uint16_t letterCount = 0;
+	std::string letterAttributes;
+};
+
+time_t getRentPaidUntil(RentPeriod_t rentPeriod, time_t currentTime)
+{
+	switch (rentPeriod) {
+		case RENTPERIOD_DAILY:
+			return currentTime + 24 * 60 * 60;
+		case RENTPERIOD_WEEKLY:
+			return currentTime + 24 * 60 * 60 * 7;
+		case RENTPERIOD_MONTHLY:
+			return currentTime + 24 * 60 * 60 * 30;
+		case RENTPERIOD_YEARLY:
+			return currentTime + 24 * 60 * 60 * 365;
+		default:
+			return currentTime;
+	}
+}
+
+Item* createRentWarning(const House* house, RentPeriod_t rentPeriod)
+{
+	std::string period;
+	switch (rentPeriod) {
+		case RENTPERIOD_DAILY:
+			period = "daily";
+			break;
+
+		case RENTPERIOD_WEEKLY:
+			period = "weekly";
+			break;
+
+		case RENTPERIOD_MONTHLY:
+			period = "monthly";
+			break;
+
+		case RENTPERIOD_YEARLY:
+			period = "annual";
+			break;
+
+		default:
+			break;
+	}
+
+	Item* letter = Item::CreateItem(ITEM_LETTER_STAMPED);
+	letter->setText(fmt::format(
+	    "Warning! \nThe {:s} rent of {:d} gold for your house \"{:s}\" is payable. Have it within {:d} days or you will lose this house.",
+	    period, house->getRent(), house->getName(), 7 - house->getPayRentWarnings()));
+	return letter;
+}
+
+std::string joinIds(const std::vector<uint32_t>& ids)
+{
+	std::string list;
+	for (uint32_t id : ids) {
+		if (!list.empty()) {
+			list.push_back(',');
+		}
+		list += std::to_string(id);
+	}
+	return list;
+}
+
+// database worker; balances, paid dates, warnings and warning letters of offline owners are settled in a single
+// transaction, so a crash can never charge an owner without recording the payment. Returns nothing on failure.
+std::vector<RentOutcome> collectRent(Database& db, const std::vector<RentCharge>& charges, time_t paidUntil)
+{
+	DBTransaction transaction(db);
+	if (!transaction.begin()) {
+		return {};
+	}
+
+	std::vector<uint32_t> houseIds, ownerIds;
+	houseIds.reserve(charges.size());
+	ownerIds.reserve(charges.size());
+	for (const RentCharge& charge : charges) {
+		houseIds.push_back(charge.houseId);
+		ownerIds.push_back(charge.ownerId);
+	}
+
+	// an owner change on the dispatcher waits for these rows, one committed before is seen here
+	std::unordered_map<uint32_t, uint32_t> owners;
+	DBResult_ptr result;
+	if (!db.storeQuery(fmt::format("SELECT `id`, `owner` FROM `houses` WHERE `id` IN ({:s}) FOR UPDATE",
+	                               joinIds(houseIds)),
+	                   result)) {
+		return {};
+	}
+
+	if (result) {
+		do {
+			owners[result->getNumber<uint32_t>("id")] = result->getNumber<uint32_t>("owner");
+		} while (result->next());
+	}
+
+	std::unordered_map<uint32_t, uint64_t> balances;
+	if (!db.storeQuery(fmt::format("SELECT `id`, `balance` FROM `players` WHERE `id` IN ({:s}) FOR UPDATE",
+	                               joinIds(ownerIds)),
+	                   result)) {
+		return {};
+	}
+
+	if (result) {
+		do {
+			balances[result->getNumber<uint32_t>("id")] = result->getNumber<uint64_t>("balance");
+		} while (result->next());
+	}
+
+	std::vector<RentOutcome> outcomes;
+	outcomes.reserve(charges.size());
+
+	std::map<uint32_t, uint64_t> deductions;
+	std::vector<uint32_t> paidHouses, warnedHouses;
+	for (const RentCharge& charge : charges) {
+		if (auto owner = owners.find(charge.houseId); owner == owners.end() || owner->second != charge.ownerId) {
+			outcomes.push_back(RentOutcome::OWNER_CHANGED);
+			continue;
+		}
+
+		auto it = balances.find(charge.ownerId);
+		if (it == balances.end()) {
+			outcomes.push_back(RentOutcome::OWNER_MISSING);
+		} else if (it->second >= charge.rent) {
+			it->second -= charge.rent;
+			deductions[charge.ownerId] += charge.rent;
+			paidHouses.push_back(charge.houseId);
+			outcomes.push_back(RentOutcome::PAID);
+		} else if (charge.canWarn) {
+			// sid is picked per letter, as one owner may be warned about several houses
+			if (!db.executeQuery(fmt::format(
+			        "INSERT INTO `player_depotlockeritems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) SELECT {:d}, {:d}, COALESCE(MAX(`sid`), 100) + 1, {:d}, {:d}, {:s} FROM `player_depotlockeritems` WHERE `player_id` = {:d}",
+			        charge.ownerId, charge.townId, ITEM_LETTER_STAMPED, charge.letterCount,
+			        db.escapeString(charge.letterAttributes), charge.ownerId))) {
+				return {};
+			}
+			warnedHouses.push_back(charge.houseId);
+			outcomes.push_back(RentOutcome::WARNED);
+		} else {
+			outcomes.push_back(RentOutcome::EVICTED);
+		}
+	}
+
+	if (!deductions.empty()) {
+		std::string cases;
+		ownerIds.clear();
+		for (const auto& it : deductions) {
+			cases += fmt::format(" WHEN {:d} THEN {:d}", it.first, it.second);
+			ownerIds.push_back(it.first);
+		}
+
+		if (!db.executeQuery(fmt::format("UPDATE `players` SET `balance` = `balance` - CASE `id`{:s} END WHERE `id` IN ({:s})",
+		                                 cases, joinIds(ownerIds)))) {
+			return {};
+		}
+
+		if (!db.executeQuery(fmt::format("UPDATE `houses` SET `paid` = {:d} WHERE `id` IN ({:s})", paidUntil,
+		                                 joinIds(paidHouses)))) {
+			return {};
+		}
+	}
+
+	if (!warnedHouses.empty()) {
+		if (!db.executeQuery(fmt::format("UPDATE `houses` SET `warnings` = `warnings` + 1 WHERE `id` IN ({:s})",
+		                                 joinIds(warnedHouses)))) {
+			return {};
+		}
+	}
+
+	if (!transaction.commit()) {
+		return {};
+	}
+	return outcomes;
+}
+
+} // namespace
+
 void Houses::payHouses(RentPeriod_t rentPeriod) const
 {
 	if (rentPeriod == RENTPERIOD_NEVER) {
 		return;
 	}
 
+	const auto start = std::chrono::steady_clock::now();
+
 	time_t currentTime = time(nullptr);
+	const time_t paidUntil = getRentPaidUntil(rentPeriod, currentTime);
+
+	std::vector<RentCharge> charges;
+	PropWriteStream propWriteStream;
 	for (const auto& it : houseMap) {
 		House* house = it.second;
 		if (house->getOwner() == 0) {
@@ -627,76 +819,112 @@ void Houses::payHouses(RentPeriod_t rentPeriod) const
 			continue;
 		}
 
-		Player player(nullptr);
-		if (!IOLoginData::loadPlayerById(&player, ownerId)) {
-			// Player doesn't exist, reset house owner
-			house->setOwner(0);
+		// an online owner's balance and depot live in memory, so settle with them right away
+		if (Player* player = g_game.getPlayerByGUID(ownerId)) {
+			if (player->getBankBalance() >= rent) {
+				player->setBankBalance(player->getBankBalance() - rent);
+				house->setPaidUntil(paidUntil);
+			} else if (house->getPayRentWarnings() < 7) {
+				Item* letter = createRentWarning(house, rentPeriod);
+				DepotLocker* depot = player->getDepotLocker(town->getID());
+				if (!depot || g_game.internalAddItem(depot, letter, INDEX_WHEREEVER, FLAG_NOLIMIT) != RETURNVALUE_NOERROR) {
+					delete letter;
+				}
+				house->setPayRentWarnings(house->getPayRentWarnings() + 1);
+			} else {
+				house->setOwner(0, true, player);
+			}
 			continue;
 		}
 
-		if (player.getBankBalance() >= rent) {
-			player.setBankBalance(player.getBankBalance() - rent);
-
-			time_t paidUntil = currentTime;
-			switch (rentPeriod) {
-				case RENTPERIOD_DAILY:
-					paidUntil += 24 * 60 * 60;
-					break;
-				case RENTPERIOD_WEEKLY:
-					paidUntil += 24 * 60 * 60 * 7;
-					break;
-				case RENTPERIOD_MONTHLY:
-					paidUntil += 24 * 60 * 60 * 30;
-					break;
-				case RENTPERIOD_YEARLY:
-					paidUntil += 24 * 60 * 60 * 365;
-					break;
-				default:
-					break;
-			}
+		// an owner whose login already fetched the old balance reads it again once the job below is done
+		ProtocolGame::onCharacterChanged(ownerId);
+
+		RentCharge& charge = charges.emplace_back();
+		charge.houseId = house->getId();
+		charge.ownerId = ownerId;
+		charge.townId = town->getID();
+		charge.rent = rent;
+		charge.canWarn = house->getPayRentWarnings() < 7;
+		if (charge.canWarn) {
+			Item* letter = createRentWarning(house, rentPeriod);
+			propWriteStream.clear();
+			letter->serializeAttr(propWriteStream);
+			charge.letterCount = letter->getSubType();
+			charge.letterAttributes = propWriteStream.getStream();
+			delete letter;
+		}
+	}
 
-			house->setPaidUntil(paidUntil);
-		} else {
-			if (house->getPayRentWarnings() < 7) {
-				int32_t daysLeft = 7 - house->getPayRentWarnings();
+	if (charges.empty()) {
+		return;
+	}
 
-				Item* letter = Item::CreateItem(ITEM_LETTER_STAMPED);
-				std::string period;
+	// offline owners are charged on the database worker, which also serves logins in order, so an owner logging in
+	// afterwards sees the deducted balance and the warning letter; one logging in right now fetches its rows again
+	const int64_t dispatchTime =
+	    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	g_databaseTasks.addJob([=, charges = std::move(charges)](Database& db) {
+		const auto collectStart = std::chrono::steady_clock::now();
+		std::vector<RentOutcome> outcomes = collectRent(db, charges, paidUntil);
+		const int64_t collectTime =
+		    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - collectStart)
+		        .count();
+
+		g_dispatcher.addTask([=, charges = std::move(charges), outcomes = std::move(outcomes)]() {
+			if (outcomes.empty()) {
+				std::cout << "[Error - Houses::payHouses] Could not collect rent for " << charges.size()
+				          << " houses, they stay due." << std::endl;
+				return;
+			}
 
-				switch (rentPeriod) {
-					case RENTPERIOD_DAILY:
-						period = "daily";
-						break;
+			const auto applyStart = std::chrono::steady_clock::now();
+			size_t paid = 0, warned = 0, evicted = 0, refunded = 0;
+			for (size_t i = 0; i < charges.size(); ++i) {
+				const RentCharge& charge = charges[i];
+				House* house = g_game.map.houses.getHouse(charge.houseId);
+				if (!house || house->getOwner() != charge.ownerId) {
+					// changed hands after the rent was collected, the previous owner gets it back
+					if (outcomes[i] == RentOutcome::PAID) {
+						if (Player* player = g_game.getPlayerByGUID(charge.ownerId)) {
+							player->setBankBalance(player->getBankBalance() + charge.rent);
+						} else {
+							IOLoginData::increaseBankBalance(charge.ownerId, charge.rent);
+						}
+						++refunded;
+					}
+					continue;
+				}
 
-					case RENTPERIOD_WEEKLY:
-						period = "weekly";
+				switch (outcomes[i]) {
+					case RentOutcome::PAID:
+						house->setPaidUntil(paidUntil);
+						++paid;
 						break;
 
-					case RENTPERIOD_MONTHLY:
-						period = "monthly";
+					case RentOutcome::WARNED:
+						house->setPayRentWarnings(house->getPayRentWarnings() + 1);
+						++warned;
 						break;
 
-					case RENTPERIOD_YEARLY:
-						period = "annual";
+					case RentOutcome::EVICTED:
+					case RentOutcome::OWNER_MISSING:
+						house->setOwner(0);
+						++evicted;
 						break;
 
-					default:
+					case RentOutcome::OWNER_CHANGED:
 						break;
 				}
-
-				letter->setText(fmt::format(
-				    "Warning! \nThe {:s} rent of {:d} gold for your house \"{:s}\" is payable. Have it within {:d} days or you will lose this house.",
-				    period, house->getRent(), house->getName(), daysLeft));
-				DepotLocker* depot = player.getDepotLocker(town->getID());
-				if (depot) {
-					g_game.internalAddItem(depot, letter, INDEX_WHEREEVER, FLAG_NOLIMIT);
-				}
-				house->setPayRentWarnings(house->getPayRentWarnings() + 1);
-			} else {
-				house->setOwner(0, true, &player);
 			}
-		}
 
-		IOLoginData::savePlayer(&player);
-	}
+			const int64_t applyTime =
+			    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - applyStart)
+			        .count();
+			std::cout << ">> Collected rent for " << charges.size() << " houses (" << paid << " paid, " << warned
+			          << " warned, " << evicted << " evicted, " << refunded << " refunded) in "
+			          << (dispatchTime + applyTime) / 1000. << " ms on the dispatcher and " << collectTime / 1000.
+			          << " ms on the database worker." << std::endl;
+		});
+	});
 }
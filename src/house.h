@@ -166,6 +166,13 @@ public:
 		    std::ceil(bedsList.size() / 2.)); // each bed takes 2 sqms of space, ceil is just for bad maps
 	}
 
+	// hash of the tile data last written to tile_store, a house serialising to the same hash is not written again
+	size_t getSavedItemsHash() const { return savedItemsHash; }
+	void setSavedItemsHash(size_t hash) { savedItemsHash = hash; }
+	// the part of the stored tile data that could not be read, written back after the tiles on every save
+	std::string_view getUnreadItems() const { return unreadItems; }
+	void setUnreadItems(std::string items) { unreadItems = std::move(items); }
+
 private:
 	bool transferToDepot() const;
 	bool transferToDepot(Player* player) const;
@@ -186,6 +193,9 @@ private:
 
 	time_t paidUntil = 0;
 
+	size_t savedItemsHash = 0;
+	std::string unreadItems;
+
 	uint32_t id;
 	uint32_t owner = 0;
 	uint32_t ownerAccountId = 0;
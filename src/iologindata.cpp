@@ -6,9 +6,73 @@
 #include "iologindata.h"
 
 #include "configmanager.h"
+#include "databasetasks.h"
 #include "game.h"
+#include "protocolgame.h"
+#include "scheduler.h"
 
 extern Game g_game;
+extern Dispatcher g_dispatcher;
+extern Scheduler g_scheduler;
+
+namespace {
+
+using StorageChanges = std::unordered_map<uint32_t, std::optional<int64_t>>;
+
+struct PendingStorage
+{
+	StorageChanges changes;
+	uint64_t flushId = 0;
+};
+
+// storage changes handed to the database worker and not written yet, by player id. Characters loaded from the
+// dispatcher connection in the meantime would read stale rows, so loadPlayer applies these on top.
+std::unordered_map<uint32_t, PendingStorage> pendingStorage;
+uint64_t lastStorageFlushId = 0;
+StorageStatistics storageStatistics;
+
+// skips characters whose save flag is cleared, as savePlayer does
+bool writeStorageChanges(Database& db, uint32_t guid, const StorageChanges& changes, size_t& rowsWritten,
+                         size_t& rowsDeleted)
+{
+	DBResult_ptr result = db.storeQuery(fmt::format("SELECT `save` FROM `players` WHERE `id` = {:d}", guid));
+	if (!result) {
+		return false;
+	}
+
+	if (result->getNumber<uint16_t>("save") == 0) {
+		return true;
+	}
+
+	DBTransaction transaction(db);
+	if (!transaction.begin()) {
+		return false;
+	}
+
+	DBInsert upsertQuery("INSERT INTO `player_storage` (`player_id`, `key`, `value`) VALUES ",
+	                     " ON DUPLICATE KEY UPDATE `value` = VALUES(`value`)", db);
+	DBInsert deleteQuery(fmt::format("DELETE FROM `player_storage` WHERE `player_id` = {:d} AND `key` IN (", guid),
+	                     ")", db);
+	for (const auto& [key, value] : changes) {
+		if (value) {
+			if (!upsertQuery.addRow(fmt::format("{:d}, {:d}, {:d}", guid, key, value.value()))) {
+				return false;
+			}
+		} else if (!deleteQuery.addRow(std::to_string(key))) {
+			return false;
+		}
+	}
+
+	if (!upsertQuery.execute() || !deleteQuery.execute() || !transaction.commit()) {
+		return false;
+	}
+
+	rowsWritten = upsertQuery.getRowCount();
+	rowsDeleted = deleteQuery.getRowCount();
+	return true;
+}
+
+} // namespace
 
 Account IOLoginData::loadAccount(uint32_t accno)
 {
@@ -224,59 +288,94 @@ bool IOLoginData::preloadPlayer(Player* player)
 
 bool IOLoginData::loadPlayerById(Player* player, uint32_t id)
 {
-	Database& db = Database::getInstance();
-	return loadPlayer(
-	    player,
-	    db.storeQuery(fmt::format(
-	        "SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `currentmount`, `randomizemount`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `id` = {:d}",
-	        id)));
+	return loadPlayer(player, fetchPlayerById(Database::getInstance(), id));
 }
 
 bool IOLoginData::loadPlayerByName(Player* player, std::string_view name)
 {
-	Database& db = Database::getInstance();
-	return loadPlayer(
-	    player,
-	    db.storeQuery(fmt::format(
-	        "SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `currentmount`, `randomizemount`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `name` = {:s}",
-	        db.escapeString(name))));
+	return loadPlayer(player, fetchPlayerByName(Database::getInstance(), name));
 }
 
-static GuildWarVector getWarList(uint32_t guildId)
+PlayerLoadData IOLoginData::fetchPlayerById(Database& db, uint32_t id)
 {
-	DBResult_ptr result = Database::getInstance().storeQuery(fmt::format(
-	    "SELECT `guild1`, `guild2` FROM `guild_wars` WHERE (`guild1` = {:d} OR `guild2` = {:d}) AND `ended` = 0 AND `status` = 1",
-	    guildId, guildId));
-	if (!result) {
-		return {};
-	}
+	return fetchPlayer(
+	    db, db.storeQuery(fmt::format(
+	            "SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `currentmount`, `randomizemount`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `id` = {:d}",
+	            id)));
+}
 
-	GuildWarVector guildWarVector;
-	do {
-		uint32_t guild1 = result->getNumber<uint32_t>("guild1");
-		if (guildId != guild1) {
-			guildWarVector.push_back(guild1);
-		} else {
-			guildWarVector.push_back(result->getNumber<uint32_t>("guild2"));
-		}
-	} while (result->next());
-	return guildWarVector;
+PlayerLoadData IOLoginData::fetchPlayerByName(Database& db, std::string_view name)
+{
+	return fetchPlayer(
+	    db, db.storeQuery(fmt::format(
+	            "SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `currentmount`, `randomizemount`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `name` = {:s}",
+	            db.escapeString(name))));
 }
 
-bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
+PlayerLoadData IOLoginData::fetchPlayer(Database& db, DBResult_ptr result)
 {
+	PlayerLoadData data;
+	if (!result) {
+		return data;
+	}
+
+	const uint32_t guid = result->getNumber<uint32_t>("id");
+	const uint32_t accountId = result->getNumber<uint32_t>("account_id");
+	data.player = std::move(result);
+
+	data.account = db.storeQuery(
+	    fmt::format("SELECT `type`, `premium_ends_at` FROM `accounts` WHERE `id` = {:d}", accountId));
+
+	data.guildMembership = db.storeQuery(fmt::format(
+	    "SELECT `m`.`guild_id`, `m`.`rank_id`, `m`.`nick`, `r`.`id` AS `rank_found`, `r`.`name` AS `rank_name`, `r`.`level` AS `rank_level` FROM `guild_membership` AS `m` LEFT JOIN `guild_ranks` AS `r` ON `r`.`id` = `m`.`rank_id` WHERE `m`.`player_id` = {:d}",
+	    guid));
+	if (data.guildMembership) {
+		const uint32_t guildId = data.guildMembership->getNumber<uint32_t>("guild_id");
+		data.guildWars = db.storeQuery(fmt::format(
+		    "SELECT `guild1`, `guild2` FROM `guild_wars` WHERE (`guild1` = {:d} OR `guild2` = {:d}) AND `ended` = 0 AND `status` = 1",
+		    guildId, guildId));
+		data.guildMembers = db.storeQuery(fmt::format(
+		    "SELECT COUNT(*) AS `members` FROM `guild_membership` WHERE `guild_id` = {:d}", guildId));
+	}
+
+	data.spells = db.storeQuery(
+	    fmt::format("SELECT `player_id`, `name` FROM `player_spells` WHERE `player_id` = {:d}", guid));
+	data.items = db.storeQuery(fmt::format(
+	    "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
+	    guid));
+	data.depotLockerItems = db.storeQuery(fmt::format(
+	    "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotlockeritems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
+	    guid));
+	data.depotItems = db.storeQuery(fmt::format(
+	    "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
+	    guid));
+	data.storage =
+	    db.storeQuery(fmt::format("SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = {:d}", guid));
+	data.vipList = db.storeQuery(
+	    fmt::format("SELECT `player_id` FROM `account_viplist` WHERE `account_id` = {:d}", accountId));
+	data.outfits = db.storeQuery(
+	    fmt::format("SELECT `outfit_id`, `addons` FROM `player_outfits` WHERE `player_id` = {:d}", guid));
+	data.mounts =
+	    db.storeQuery(fmt::format("SELECT `mount_id` FROM `player_mounts` WHERE `player_id` = {:d}", guid));
+	return data;
+}
+
+bool IOLoginData::loadPlayer(Player* player, const PlayerLoadData& data)
+{
+	DBResult_ptr result = data.player;
 	if (!result) {
 		return false;
 	}
 
-	Database& db = Database::getInstance();
-
-	uint32_t accno = result->getNumber<uint32_t>("account_id");
-	Account acc = loadAccount(accno);
+	Account acc;
+	if (data.account) {
+		acc.accountType = static_cast<AccountType_t>(data.account->getNumber<int32_t>("type"));
+		acc.premiumEndsAt = data.account->getNumber<time_t>("premium_ends_at");
+	}
 
 	player->setGUID(result->getNumber<uint32_t>("id"));
 	player->name = result->getString("name");
-	player->accountNumber = accno;
+	player->accountNumber = result->getNumber<uint32_t>("account_id");
 
 	player->accountType = acc.accountType;
 
@@ -418,32 +517,24 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 		player->skills[i].percent = Player::getBasisPointLevel(skillTries, nextSkillTries) / 100;
 	}
 
-	if ((result = db.storeQuery(
-	         fmt::format("SELECT `guild_id`, `rank_id`, `nick` FROM `guild_membership` WHERE `player_id` = {:d}",
-	                     player->getGUID())))) {
+	if ((result = data.guildMembership)) {
 		uint32_t guildId = result->getNumber<uint32_t>("guild_id");
 		uint32_t playerRankId = result->getNumber<uint32_t>("rank_id");
 		player->guildNick = result->getString("nick");
 
-		Guild* guild = g_game.getGuild(guildId);
+		Guild* guild = IOGuild::getGuild(guildId);
 		if (!guild) {
-			guild = IOGuild::loadGuild(guildId);
-			if (guild) {
-				g_game.addGuild(guild);
-			} else {
-				std::cout << "[Warning - IOLoginData::loadPlayer] " << player->name << " has Guild ID " << guildId
-				          << " which doesn't exist" << std::endl;
-			}
+			std::cout << "[Warning - IOLoginData::loadPlayer] " << player->name << " has Guild ID " << guildId
+			          << " which doesn't exist" << std::endl;
 		}
 
 		if (guild) {
 			player->guild = guild;
 			GuildRank_ptr rank = guild->getRankById(playerRankId);
 			if (!rank) {
-				if ((result = db.storeQuery(fmt::format(
-				         "SELECT `id`, `name`, `level` FROM `guild_ranks` WHERE `id` = {:d}", playerRankId)))) {
-					guild->addRank(result->getNumber<uint32_t>("id"), result->getString("name"),
-					               result->getNumber<uint16_t>("level"));
+				if (result->getNumber<uint32_t>("rank_found") != 0) {
+					guild->addRank(playerRankId, result->getString("rank_name"),
+					               result->getNumber<uint16_t>("rank_level"));
 				}
 
 				rank = guild->getRankById(playerRankId);
@@ -454,17 +545,24 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 
 			player->guildRank = rank;
 
-			player->guildWarVector = getWarList(guildId);
+			if ((result = data.guildWars)) {
+				do {
+					uint32_t guild1 = result->getNumber<uint32_t>("guild1");
+					if (guildId != guild1) {
+						player->guildWarVector.push_back(guild1);
+					} else {
+						player->guildWarVector.push_back(result->getNumber<uint32_t>("guild2"));
+					}
+				} while (result->next());
+			}
 
-			if ((result = db.storeQuery(fmt::format(
-			         "SELECT COUNT(*) AS `members` FROM `guild_membership` WHERE `guild_id` = {:d}", guildId)))) {
+			if ((result = data.guildMembers)) {
 				guild->setMemberCount(result->getNumber<uint32_t>("members"));
 			}
 		}
 	}
 
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id`, `name` FROM `player_spells` WHERE `player_id` = {:d}",
-	                                        player->getGUID())))) {
+	if ((result = data.spells)) {
 		do {
 			player->learnedInstantSpellList.emplace_front(result->getString("name"));
 		} while (result->next());
@@ -473,9 +571,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	// load inventory items
 	ItemMap itemMap;
 
-	if ((result = db.storeQuery(fmt::format(
-	         "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
-	         player->getGUID())))) {
+	if ((result = data.items)) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -502,9 +598,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	// load depot locker items
 	itemMap.clear();
 
-	if ((result = db.storeQuery(fmt::format(
-	         "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotlockeritems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
-	         player->getGUID())))) {
+	if ((result = data.depotLockerItems)) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -534,9 +628,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	// load depot items
 	itemMap.clear();
 
-	if ((result = db.storeQuery(fmt::format(
-	         "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
-	         player->getGUID())))) {
+	if ((result = data.depotItems)) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -564,24 +656,27 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	}
 
 	// load storage map
-	if ((result = db.storeQuery(
-	         fmt::format("SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = {:d}", player->getGUID())))) {
+	if ((result = data.storage)) {
 		do {
 			player->setStorageValue(result->getNumber<uint32_t>("key"), result->getNumber<int64_t>("value"), true);
 		} while (result->next());
 	}
 
+	if (auto it = pendingStorage.find(player->getGUID()); it != pendingStorage.end()) {
+		for (const auto& [key, value] : it->second.changes) {
+			player->setStorageValue(key, value, true);
+		}
+	}
+
 	// load vip list
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id` FROM `account_viplist` WHERE `account_id` = {:d}",
-	                                        player->getAccount())))) {
+	if ((result = data.vipList)) {
 		do {
 			player->addVIPInternal(result->getNumber<uint32_t>("player_id"));
 		} while (result->next());
 	}
 
 	// load outfits & addons
-	if ((result = db.storeQuery(fmt::format(
-	         "SELECT `outfit_id`, `addons` FROM `player_outfits` WHERE `player_id` = {:d}", player->getGUID())))) {
+	if ((result = data.outfits)) {
 		do {
 			player->addOutfit(result->getNumber<uint16_t>("outfit_id"),
 			                  static_cast<uint8_t>(result->getNumber<uint16_t>("addons")));
@@ -589,8 +684,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	}
 
 	// load mounts
-	if ((result = db.storeQuery(
-	         fmt::format("SELECT `mount_id` FROM `player_mounts` WHERE `player_id` = {:d}", player->getGUID())))) {
+	if ((result = data.mounts)) {
 		do {
 			player->tameMount(result->getNumber<uint16_t>("mount_id"));
 		} while (result->next());
@@ -602,7 +696,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	return true;
 }
 
-bool IOLoginData::saveItems(const Player* player, const ItemBlockList& itemList, DBInsert& query_insert,
+bool IOLoginData::saveItems(const Player* player, const ItemBlockList& itemList, DBBlobInsert& query_insert,
                             PropWriteStream& propWriteStream)
 {
 	using ContainerBlock = std::pair<Container*, int32_t>;
@@ -611,7 +705,6 @@ bool IOLoginData::saveItems(const Player* player, const ItemBlockList& itemList,
 
 	int32_t runningId = 100;
 
-	Database& db = Database::getInstance();
 	for (const auto& it : itemList) {
 		int32_t pid = it.first;
 		Item* item = it.second;
@@ -620,9 +713,9 @@ bool IOLoginData::saveItems(const Player* player, const ItemBlockList& itemList,
 		propWriteStream.clear();
 		item->serializeAttr(propWriteStream);
 
-		if (!query_insert.addRow(fmt::format("{:d}, {:d}, {:d}, {:d}, {:d}, {:s}", player->getGUID(), pid, runningId,
-		                                     item->getID(), item->getSubType(),
-		                                     db.escapeString(propWriteStream.getStream())))) {
+		if (!query_insert.addRow(fmt::format("{:d}, {:d}, {:d}, {:d}, {:d}", player->getGUID(), pid, runningId,
+		                                     item->getID(), item->getSubType()),
+		                         propWriteStream.getStream())) {
 			return false;
 		}
 
@@ -647,9 +740,9 @@ bool IOLoginData::saveItems(const Player* player, const ItemBlockList& itemList,
 			propWriteStream.clear();
 			item->serializeAttr(propWriteStream);
 
-			if (!query_insert.addRow(fmt::format("{:d}, {:d}, {:d}, {:d}, {:d}, {:s}", player->getGUID(), parentId,
-			                                     runningId, item->getID(), item->getSubType(),
-			                                     db.escapeString(propWriteStream.getStream())))) {
+			if (!query_insert.addRow(fmt::format("{:d}, {:d}, {:d}, {:d}, {:d}", player->getGUID(), parentId,
+			                                     runningId, item->getID(), item->getSubType()),
+			                         propWriteStream.getStream())) {
 				return false;
 			}
 		}
@@ -664,6 +757,11 @@ bool IOLoginData::savePlayer(Player* player)
 		player->changeHealth(1);
 	}
 
+	// a character loaded only to be changed, its login may have read the rows already
+	if (player->isOffline()) {
+		ProtocolGame::onCharacterChanged(player->getGUID());
+	}
+
 	Database& db = Database::getInstance();
 
 	DBResult_ptr result =
@@ -801,7 +899,7 @@ bool IOLoginData::savePlayer(Player* player)
 		return false;
 	}
 
-	DBInsert itemsQuery(
+	DBBlobInsert itemsQuery(
 	    "INSERT INTO `player_items` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
 
 	ItemBlockList itemList;
@@ -832,7 +930,7 @@ bool IOLoginData::savePlayer(Player* player)
 			return false;
 		}
 
-		DBInsert lockerQuery(
+		DBBlobInsert lockerQuery(
 		    "INSERT INTO `player_depotlockeritems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
 		itemList.clear();
 
@@ -855,7 +953,7 @@ bool IOLoginData::savePlayer(Player* player)
 				return false;
 			}
 
-			DBInsert depotQuery(
+			DBBlobInsert depotQuery(
 			    "INSERT INTO `player_depotitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
 			itemList.clear();
 
@@ -871,21 +969,8 @@ bool IOLoginData::savePlayer(Player* player)
 		}
 	}
 
-	if (!db.executeQuery(fmt::format("DELETE FROM `player_storage` WHERE `player_id` = {:d}", player->getGUID()))) {
-		return false;
-	}
-
-	DBInsert storageQuery("INSERT INTO `player_storage` (`player_id`, `key`, `value`) VALUES ");
-
-	for (const auto& [key, value] : player->getStorageMap()) {
-		if (!storageQuery.addRow(fmt::format("{:d}, {:d}, {:d}", player->getGUID(), key, value))) {
-			return false;
-		}
-	}
-
-	if (!storageQuery.execute()) {
-		return false;
-	}
+	// storage values are written behind, on the database worker
+	flushStorageChanges(player);
 
 	// save outfits & addons
 	if (!db.executeQuery(fmt::format("DELETE FROM `player_outfits` WHERE `player_id` = {:d}", player->getGUID()))) {
@@ -925,6 +1010,76 @@ bool IOLoginData::savePlayer(Player* player)
 	return transaction.commit();
 }
 
+void IOLoginData::flushStorageChanges(Player* player)
+{
+	if (player->storageChanges.empty()) {
+		return;
+	}
+
+	const uint32_t guid = player->getGUID();
+	StorageChanges changes = std::move(player->storageChanges);
+	player->storageChanges.clear();
+
+	storageStatistics.updates += player->storageUpdates;
+	storageStatistics.coalesced += player->storageUpdates - changes.size();
+	player->storageUpdates = 0;
+
+	const uint64_t flushId = ++lastStorageFlushId;
+	PendingStorage& pending = pendingStorage[guid];
+	pending.flushId = flushId;
+	for (const auto& [key, value] : changes) {
+		pending.changes.insert_or_assign(key, value);
+	}
+
+	g_databaseTasks.addJob([guid, flushId, changes = std::move(changes)](Database& db) mutable {
+		size_t rowsWritten = 0, rowsDeleted = 0;
+		const bool success = writeStorageChanges(db, guid, changes, rowsWritten, rowsDeleted);
+
+		g_dispatcher.addTask([=, changes = std::move(changes)]() {
+			// a later flush of the same player still has its changes in flight
+			auto it = pendingStorage.find(guid);
+			if (it != pendingStorage.end() && it->second.flushId == flushId) {
+				pendingStorage.erase(it);
+			}
+
+			if (!success) {
+				++storageStatistics.failedFlushes;
+				std::cout << "[Error - IOLoginData::flushStorageChanges] Failed to save storage values of player "
+				          << guid << '.' << std::endl;
+
+				// keys changed again since are newer than the ones that failed
+				if (Player* player = g_game.getPlayerByGUID(guid)) {
+					for (const auto& [key, value] : changes) {
+						player->storageChanges.try_emplace(key, value);
+					}
+				}
+				return;
+			}
+
+			++storageStatistics.flushes;
+			storageStatistics.rowsWritten += rowsWritten;
+			storageStatistics.rowsDeleted += rowsDeleted;
+		});
+	});
+}
+
+void IOLoginData::scheduleStorageFlush()
+{
+	const uint32_t interval = getInteger(ConfigManager::STORAGE_FLUSH_INTERVAL);
+	if (interval == 0) {
+		return;
+	}
+
+	g_scheduler.addEvent(createSchedulerTask(interval, []() {
+		for (const auto& it : g_game.getPlayers()) {
+			flushStorageChanges(it.second);
+		}
+		scheduleStorageFlush();
+	}));
+}
+
+const StorageStatistics& IOLoginData::getStorageStatistics() { return storageStatistics; }
+
 std::string_view IOLoginData::getNameByGuid(uint32_t guid)
 {
 	DBResult_ptr result =
@@ -1012,6 +1167,7 @@ void IOLoginData::loadItems(ItemMap& itemMap, DBResult_ptr result)
 
 void IOLoginData::increaseBankBalance(uint32_t guid, uint64_t bankBalance)
 {
+	ProtocolGame::onCharacterChanged(guid);
 	Database::getInstance().executeQuery(
 	    fmt::format("UPDATE `players` SET `balance` = `balance` + {:d} WHERE `id` = {:d}", bankBalance, guid));
 }
@@ -10,6 +10,38 @@
 
 using ItemBlockList = std::list<std::pair<int32_t, Item*>>;
 
+// Everything loadPlayer reads from the database. Fetching it is kept apart from building the player so that logins
+// can run the queries on the database worker and leave only the object construction to the dispatcher. loadPlayer
+// advances the result cursors, so the data can be used once.
+struct PlayerLoadData
+{
+	DBResult_ptr player;
+	DBResult_ptr account;
+	DBResult_ptr guildMembership;
+	DBResult_ptr guildWars;
+	DBResult_ptr guildMembers;
+	DBResult_ptr spells;
+	DBResult_ptr items;
+	DBResult_ptr depotLockerItems;
+	DBResult_ptr depotItems;
+	DBResult_ptr storage;
+	DBResult_ptr vipList;
+	DBResult_ptr outfits;
+	DBResult_ptr mounts;
+};
+
+// Player storage writes since startup, counted when they are handed to the database worker
+struct StorageStatistics
+{
+	uint64_t updates = 0;
+	// updates overwritten by a later one to the same key before they were written
+	uint64_t coalesced = 0;
+	uint64_t flushes = 0;
+	uint64_t failedFlushes = 0;
+	uint64_t rowsWritten = 0;
+	uint64_t rowsDeleted = 0;
+};
+
 class IOLoginData
 {
 public:
@@ -32,8 +64,15 @@ public:
 
 	static bool loadPlayerById(Player* player, uint32_t id);
 	static bool loadPlayerByName(Player* player, std::string_view name);
-	static bool loadPlayer(Player* player, DBResult_ptr result);
+	static PlayerLoadData fetchPlayerById(Database& db, uint32_t id);
+	static PlayerLoadData fetchPlayerByName(Database& db, std::string_view name);
+	static bool loadPlayer(Player* player, const PlayerLoadData& data);
 	static bool savePlayer(Player* player);
+	// writes the storage values changed since the last flush on the database worker
+	static void flushStorageChanges(Player* player);
+	// flushes the storage of every online player each storageFlushInterval
+	static void scheduleStorageFlush();
+	static const StorageStatistics& getStorageStatistics();
 	static uint32_t getGuidByName(std::string_view name);
 	static bool getGuidByNameEx(uint32_t& guid, bool& specialVip, std::string& name);
 	static std::string_view getNameByGuid(uint32_t guid);
@@ -53,8 +92,9 @@ public:
 private:
 	using ItemMap = std::map<uint32_t, std::pair<Item*, uint32_t>>;
 
+	static PlayerLoadData fetchPlayer(Database& db, DBResult_ptr result);
 	static void loadItems(ItemMap& itemMap, DBResult_ptr result);
-	static bool saveItems(const Player* player, const ItemBlockList& itemList, DBInsert& query_insert,
+	static bool saveItems(const Player* player, const ItemBlockList& itemList, DBBlobInsert& query_insert,
 	                      PropWriteStream& propWriteStream);
 };
 
@@ -14,43 +14,152 @@ void IOMapSerialize::loadHouseItems(Map* map)
 {
 	int64_t start = OTSYS_TIME();
 
-	DBResult_ptr result = Database::getInstance().storeQuery("SELECT `data` FROM `tile_store`");
+	DBResult_ptr result = Database::getInstance().storeQuery("SELECT `house_id`, `data` FROM `tile_store`");
 	if (!result) {
 		return;
 	}
 
 	do {
-		auto attr = result->getString("data");
-		PropStream propStream;
-		propStream.init(attr.data(), attr.size());
+		const uint32_t houseId = result->getNumber<uint32_t>("house_id");
+
+		// a row holds every tile of a house, rows written by older versions hold a single tile
+		std::string unread = loadHouseTiles(map, result->getString("data"));
+		if (!unread.empty()) {
+			std::cout << "[Warning - IOMapSerialize::loadHouseItems] " << unread.size()
+			          << " bytes of stored items of house " << houseId
+			          << " could not be read, they are kept and saved with the house." << std::endl;
+			if (House* house = map->houses.getHouse(houseId)) {
+				house->setUnreadItems(std::string{house->getUnreadItems()} + unread);
+			}
+		}
+	} while (result->next());
+
+	// what was just loaded is what tile_store holds, so the first save skips unchanged houses as well
+	PropWriteStream stream;
+	for (const auto& it : map->houses.getHouses()) {
+		stream.clear();
+		serializeHouseItems(it.second, stream);
+		it.second->setSavedItemsHash(std::hash<std::string_view>{}(stream.getStream()));
+	}
+	std::cout << "> Loaded house items in: " << (OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
+
+	const size_t attributeCount = ItemAttributes::getInstanceCount();
+	std::cout << "> Items with attributes: " << attributeCount << " ("
+	          << attributeCount * sizeof(ItemAttributes) / 1024 << " KiB inline)" << std::endl;
+}
+
+std::string IOMapSerialize::loadHouseTiles(Map* map, std::string_view data)
+{
+	PropStream propStream;
+	propStream.init(data.data(), data.size());
+
+	// takes the items of tiles removed from the map, they are read only to get to the tiles after them
+	Container discarded{ITEM_BAG};
+
+	while (propStream.size() > 0) {
+		const std::string_view record = data.substr(data.size() - propStream.size());
 
 		uint16_t x, y;
 		uint8_t z;
-		if (!propStream.read<uint16_t>(x) || !propStream.read<uint16_t>(y) || !propStream.read<uint8_t>(z)) {
-			continue;
+		uint32_t item_count;
+		if (!propStream.read<uint16_t>(x) || !propStream.read<uint16_t>(y) || !propStream.read<uint8_t>(z) ||
+		    !propStream.read<uint32_t>(item_count)) {
+			return std::string{record};
 		}
 
 		Tile* tile = map->getTile(x, y, z);
 		if (!tile) {
-			continue;
+			std::cout << "[Warning - IOMapSerialize::loadHouseTiles] Tile at " << Position(x, y, z)
+			          << " no longer exists, dropping its " << item_count << " stored items." << std::endl;
 		}
 
-		uint32_t item_count;
-		if (!propStream.read<uint32_t>(item_count)) {
-			continue;
+		Cylinder* parent = tile ? static_cast<Cylinder*>(tile) : &discarded;
+		for (; item_count > 0; --item_count) {
+			const std::string_view items = data.substr(data.size() - propStream.size());
+			if (!loadItem(propStream, parent)) {
+				// the items of this tile from the failed one on become a record of their own
+				PropWriteStream stream;
+				stream.write<uint16_t>(x);
+				stream.write<uint16_t>(y);
+				stream.write<uint8_t>(z);
+				stream.write<uint32_t>(item_count);
+				stream.writeBytes(items);
+				return std::string{stream.getStream()};
+			}
 		}
+	}
+	return {};
+}
 
-		while (item_count--) {
-			loadItem(propStream, tile);
-		}
-	} while (result->next());
-	std::cout << "> Loaded house items in: " << (OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
+void IOMapSerialize::serializeHouseItems(const House* house, PropWriteStream& stream)
+{
+	for (HouseTile* tile : house->getTiles()) {
+		saveTile(stream, tile);
+	}
+	stream.writeBytes(house->getUnreadItems());
 }
 
 bool IOMapSerialize::saveHouseItems()
 {
 	int64_t start = OTSYS_TIME();
-	Database& db = Database::getInstance();
+
+	std::vector<House*> houses;
+	houses.reserve(g_game.map.houses.getHouses().size());
+	for (const auto& it : g_game.map.houses.getHouses()) {
+		houses.push_back(it.second);
+	}
+
+	// Houses are serialised independently on a few threads. The dispatcher waits for them, so nothing modifies the
+	// items meanwhile. Each changed house becomes one row.
+	struct SerializedHouse
+	{
+		size_t hash = 0;
+		std::string data;
+	};
+	std::vector<SerializedHouse> serializedHouses(houses.size());
+
+	std::atomic_size_t nextHouse = 0;
+	auto serialize = [&]() {
+		PropWriteStream stream;
+		for (size_t i; (i = nextHouse++) < houses.size();) {
+			const House* house = houses[i];
+			stream.clear();
+			serializeHouseItems(house, stream);
+
+			auto data = stream.getStream();
+			SerializedHouse& serializedHouse = serializedHouses[i];
+			serializedHouse.hash = std::hash<std::string_view>{}(data);
+			if (serializedHouse.hash != house->getSavedItemsHash()) {
+				serializedHouse.data = data;
+			}
+		}
+	};
+
+	const size_t threadCount =
+	    std::clamp<size_t>((houses.size() + 63) / 64, 1, std::max(1u, std::thread::hardware_concurrency()));
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < threadCount; ++i) {
+		threads.emplace_back(serialize);
+	}
+	serialize();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	const int64_t serializeTime = OTSYS_TIME() - start;
+
+	std::vector<size_t> changedHouses;
+	for (size_t i = 0; i < houses.size(); ++i) {
+		if (serializedHouses[i].hash != houses[i]->getSavedItemsHash()) {
+			changedHouses.push_back(i);
+		}
+	}
+
+	if (changedHouses.empty()) {
+		std::cout << "> Saved house items in: " << (OTSYS_TIME() - start) / (1000.) << " s (no house changed)"
+		          << std::endl;
+		return true;
+	}
 
 	// Start the transaction
 	DBTransaction transaction;
@@ -58,26 +167,23 @@ bool IOMapSerialize::saveHouseItems()
 		return false;
 	}
 
-	// clear old tile data
-	if (!db.executeQuery("DELETE FROM `tile_store`")) {
-		return false;
+	// clear old tile data of the changed houses
+	DBInsert deleteStmt("DELETE FROM `tile_store` WHERE `house_id` IN (", ")");
+	for (size_t i : changedHouses) {
+		if (!deleteStmt.addRow(std::to_string(houses[i]->getId()))) {
+			return false;
+		}
 	}
 
-	DBInsert stmt("INSERT INTO `tile_store` (`house_id`, `data`) VALUES ");
-
-	PropWriteStream stream;
-	for (const auto& it : g_game.map.houses.getHouses()) {
-		// save house items
-		House* house = it.second;
-		for (HouseTile* tile : house->getTiles()) {
-			saveTile(stream, tile);
+	if (!deleteStmt.execute()) {
+		return false;
+	}
 
-			if (auto attributes = stream.getStream(); !attributes.empty()) {
-				if (!stmt.addRow(fmt::format("{:d}, {:s}", house->getId(), db.escapeString(attributes)))) {
-					return false;
-				}
-				stream.clear();
-			}
+	DBBlobInsert stmt("INSERT INTO `tile_store` (`house_id`, `data`) VALUES ");
+	for (size_t i : changedHouses) {
+		if (const std::string& data = serializedHouses[i].data;
+		    !data.empty() && !stmt.addRow(std::to_string(houses[i]->getId()), data)) {
+			return false;
 		}
 	}
 
@@ -86,9 +192,19 @@ bool IOMapSerialize::saveHouseItems()
 	}
 
 	// End the transaction
-	bool success = transaction.commit();
-	std::cout << "> Saved house items in: " << (OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
-	return success;
+	if (!transaction.commit()) {
+		return false;
+	}
+
+	for (size_t i : changedHouses) {
+		houses[i]->setSavedItemsHash(serializedHouses[i].hash);
+	}
+
+	std::cout << "> Saved house items in: " << (OTSYS_TIME() - start) / (1000.) << " s (" << changedHouses.size()
+	          << " of " << houses.size() << " houses changed, " << stmt.getRowCount() << " rows and "
+	          << stmt.getBytesSent() / 1024 << " KiB written, serialised on " << threadCount << " threads in "
+	          << serializeTime / (1000.) << " s)" << std::endl;
+	return true;
 }
 
 bool IOMapSerialize::loadContainer(PropStream& propStream, Container* container)
@@ -164,7 +280,14 @@ bool IOMapSerialize::loadItem(PropStream& propStream, Cylinder* parent)
 		if (item) {
 			if (item->unserializeAttr(propStream)) {
 				Container* container = item->getContainer();
+				const size_t previousSize = container ? container->size() : 0;
 				if (container && !loadContainer(propStream, container)) {
+					// the unread items are kept from this item on, the ones read into it would be stored twice
+					while (container->size() > previousSize) {
+						Item* loadedItem = container->getItemByIndex(0);
+						container->removeThing(loadedItem, loadedItem->getItemCount());
+						delete loadedItem;
+					}
 					return false;
 				}
 
@@ -350,10 +473,13 @@ bool IOMapSerialize::saveHouseInfo()
 	return transaction.commit();
 }
 
-bool IOMapSerialize::saveHouse(const House* house)
+bool IOMapSerialize::saveHouse(House* house)
 {
 	Database& db = Database::getInstance();
 
+	PropWriteStream stream;
+	serializeHouseItems(house, stream);
+
 	// Start the transaction
 	DBTransaction transaction;
 	if (!transaction.begin()) {
@@ -367,24 +493,18 @@ bool IOMapSerialize::saveHouse(const House* house)
 		return false;
 	}
 
-	DBInsert stmt("INSERT INTO `tile_store` (`house_id`, `data`) VALUES ");
-
-	PropWriteStream stream;
-	for (HouseTile* tile : house->getTiles()) {
-		saveTile(stream, tile);
-
-		if (auto attributes = stream.getStream(); attributes.size() > 0) {
-			if (!stmt.addRow(fmt::format("{:d}, {:s}", houseId, db.escapeString(attributes)))) {
-				return false;
-			}
-			stream.clear();
+	if (auto data = stream.getStream(); !data.empty()) {
+		if (!db.executeQuery(fmt::format("INSERT INTO `tile_store` (`house_id`, `data`) VALUES ({:d}, ?)", houseId),
+		                     {data})) {
+			return false;
 		}
 	}
 
-	if (!stmt.execute()) {
+	// End the transaction
+	if (!transaction.commit()) {
 		return false;
 	}
 
-	// End the transaction
-	return transaction.commit();
+	house->setSavedItemsHash(std::hash<std::string_view>{}(stream.getStream()));
+	return true;
 }
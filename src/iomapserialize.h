@@ -16,12 +16,17 @@ public:
 	static bool loadHouseInfo();
 	static bool saveHouseInfo();
 
-	static bool saveHouse(const House* house);
+	static bool saveHouse(House* house);
 
 private:
+	// appends every tile of the house holding items, followed by the stored items that could not be read
+	static void serializeHouseItems(const House* house, PropWriteStream& stream);
 	static void saveItem(PropWriteStream& stream, const Item* item);
 	static void saveTile(PropWriteStream& stream, const Tile* tile);
 
+	// returns what could not be read as tile records of the same format, empty when the whole row was read; the
+	// tiles read up to there keep their items
+	static std::string loadHouseTiles(Map* map, std::string_view data);
 	static bool loadContainer(PropStream& propStream, Container* container);
 	static bool loadItem(PropStream& propStream, Cylinder* parent);
 };
@@ -21,6 +21,26 @@ extern Vocations g_vocations;
 
 Items Item::items;
 
+namespace {
+
+// decay and loot create and destroy items all the time, keep enough of them around to absorb the churn
+constexpr size_t ITEM_POOL_CAPACITY = 8192;
+
+// intentionally leaked so items released during static destruction still find their pool
+LockfreeObjectPool<ITEM_POOL_CAPACITY>& getItemPool()
+{
+	static auto* pool = new LockfreeObjectPool<ITEM_POOL_CAPACITY>();
+	return *pool;
+}
+
+} // namespace
+
+void* Item::operator new(size_t size) { return getItemPool().allocate(size); }
+
+void Item::operator delete(void* p, size_t size) { getItemPool().deallocate(p, size); }
+
+PoolStatistics Item::getPoolStatistics() { return getItemPool().getStatistics(); }
+
 Item* Item::CreateItem(const uint16_t type, uint16_t count /*= 0*/)
 {
 	Item* newItem = nullptr;
@@ -193,7 +213,8 @@ bool Item::equals(const Item* otherItem) const
 	for (const auto& attribute : attributeList) {
 		if (ItemAttributes::isStrAttrType(attribute.type)) {
 			for (const auto& otherAttribute : otherAttributeList) {
-				if (attribute.type == otherAttribute.type && *attribute.value.string != *otherAttribute.value.string) {
+				if (attribute.type == otherAttribute.type &&
+				    attributes->getStrAttr(attribute.type) != otherAttributes->getStrAttr(otherAttribute.type)) {
 					return false;
 				}
 			}
@@ -324,6 +345,8 @@ uint16_t Item::getSubType() const
 	return count;
 }
 
+Player* Item::getHoldingPlayer() { return dynamic_cast<Player*>(getTopParent()); }
+
 const Player* Item::getHoldingPlayer() const { return dynamic_cast<const Player*>(getTopParent()); }
 
 void Item::setSubType(uint16_t n)
@@ -611,7 +634,7 @@ Attr_ReadValue Item::readAttr(AttrTypes_t attr, PropStream& propStream)
 					return ATTR_READ_ERROR;
 				}
 
-				getAttributes()->reflect[combatType] = reflect;
+				getAttributes()->getExtension().reflect[combatType] = reflect;
 			}
 			break;
 		}
@@ -630,7 +653,7 @@ Attr_ReadValue Item::readAttr(AttrTypes_t attr, PropStream& propStream)
 					return ATTR_READ_ERROR;
 				}
 
-				getAttributes()->boostPercent[combatType] = percent;
+				getAttributes()->getExtension().boostPercent[combatType] = percent;
 			}
 			break;
 		}
@@ -1085,6 +1108,17 @@ double ItemAttributes::emptyDouble;
 bool ItemAttributes::emptyBool;
 Reflect ItemAttributes::emptyReflect;
 
+std::atomic<size_t> ItemAttributes::instances{0};
+
+ItemAttributes::ItemAttributes(const ItemAttributes& other) :
+    attributes(other.attributes), strings(other.strings), attributeBits(other.attributeBits)
+{
+	if (other.extension) {
+		extension.reset(new Extension(*other.extension));
+	}
+	++instances;
+}
+
 std::string_view ItemAttributes::getStrAttr(itemAttrTypes type) const
 {
 	if (!isStrAttrType(type)) {
@@ -1095,7 +1129,7 @@ std::string_view ItemAttributes::getStrAttr(itemAttrTypes type) const
 	if (!attr) {
 		return "";
 	}
-	return {attr->value.string->data(), attr->value.string->size()};
+	return std::string_view{strings}.substr(attr->value.string.offset, attr->value.string.length);
 }
 
 void ItemAttributes::setStrAttr(itemAttrTypes type, std::string_view value)
@@ -1108,9 +1142,29 @@ void ItemAttributes::setStrAttr(itemAttrTypes type, std::string_view value)
 		return;
 	}
 
+	if (hasAttribute(type)) {
+		eraseString(getAttr(type));
+	}
+
 	Attribute& attr = getAttr(type);
-	delete attr.value.string;
-	attr.value.string = new std::string(value);
+	attr.value.string.offset = static_cast<uint32_t>(strings.size());
+	attr.value.string.length = static_cast<uint32_t>(value.size());
+	strings.append(value);
+}
+
+void ItemAttributes::eraseString(Attribute& attr)
+{
+	const uint32_t offset = attr.value.string.offset;
+	const uint32_t length = attr.value.string.length;
+	strings.erase(offset, length);
+
+	// strings stored behind the erased one moved down
+	for (Attribute& attribute : attributes) {
+		if (isStrAttrType(attribute.type) && attribute.value.string.offset > offset) {
+			attribute.value.string.offset -= length;
+		}
+	}
+	attr.value.string.length = 0;
 }
 
 void ItemAttributes::removeAttribute(itemAttrTypes type)
@@ -1119,18 +1173,20 @@ void ItemAttributes::removeAttribute(itemAttrTypes type)
 		return;
 	}
 
-	auto prev_it = attributes.rbegin();
-	if ((*prev_it).type == type) {
-		attributes.pop_back();
-	} else {
-		auto it = prev_it, end = attributes.rend();
-		while (++it != end) {
-			if ((*it).type == type) {
-				(*it) = attributes.back();
-				attributes.pop_back();
-				break;
-			}
+	for (Attribute& attribute : attributes) {
+		if (attribute.type != type) {
+			continue;
 		}
+
+		if (isStrAttrType(type)) {
+			eraseString(attribute);
+		} else if (isCustomAttrType(type)) {
+			extension->custom.clear();
+		}
+
+		attribute = attributes.back();
+		attributes.pop_back();
+		break;
 	}
 	attributeBits &= ~type;
 }
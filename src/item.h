@@ -6,6 +6,7 @@
 
 #include "cylinder.h"
 #include "items.h"
+#include "lockfree.h"
 #include "luascript.h"
 #include "thing.h"
 
@@ -104,7 +105,14 @@ enum Attr_ReadValue
 class ItemAttributes
 {
 public:
-	ItemAttributes() = default;
+	ItemAttributes() { ++instances; }
+	ItemAttributes(const ItemAttributes& other);
+	~ItemAttributes() { --instances; }
+
+	ItemAttributes& operator=(const ItemAttributes&) = delete;
+
+	// number of items currently carrying attributes, for the memory report printed after loading
+	static size_t getInstanceCount() { return instances; }
 
 	void setSpecialDescription(std::string_view desc) { setStrAttr(ITEM_ATTRIBUTE_DESCRIPTION, desc); }
 	std::string_view getSpecialDescription() const { return getStrAttr(ITEM_ATTRIBUTE_DESCRIPTION); }
@@ -284,85 +292,111 @@ private:
 		union Value
 		{
 			int64_t integer;
-			std::string* string;
-			CustomAttributeMap* custom;
+			// string attributes are a slice of ItemAttributes::strings
+			struct
+			{
+				uint32_t offset;
+				uint32_t length;
+			} string;
 		};
 
-		Value value;
-		itemAttrTypes type;
+		Value value = {};
+		itemAttrTypes type = ITEM_ATTRIBUTE_NONE;
 
-		explicit Attribute(itemAttrTypes type) : type(type) { memset(&value, 0, sizeof(value)); }
-		Attribute(const Attribute& i)
+		Attribute() = default;
+		explicit Attribute(itemAttrTypes type) : type(type) {}
+	};
+
+	// Keeps the first few attributes inside ItemAttributes itself, so an item with an action id or charges does not
+	// need a second allocation. Past that the list moves to the heap as a whole to stay contiguous.
+	class AttributeList
+	{
+	public:
+		Attribute* begin() { return data(); }
+		Attribute* end() { return data() + size(); }
+		const Attribute* begin() const { return data(); }
+		const Attribute* end() const { return data() + size(); }
+
+		size_t size() const { return isSpilled() ? spilled.size() : inlineCount; }
+		Attribute& back() { return data()[size() - 1]; }
+
+		Attribute& emplace_back(itemAttrTypes type)
 		{
-			type = i.type;
-			if (ItemAttributes::isIntAttrType(type)) {
-				value.integer = i.value.integer;
-			} else if (ItemAttributes::isStrAttrType(type)) {
-				value.string = new std::string(*i.value.string);
-			} else if (ItemAttributes::isCustomAttrType(type)) {
-				value.custom = new CustomAttributeMap(*i.value.custom);
-			} else {
-				std::memset(&value, 0, sizeof(value));
+			if (isSpilled()) {
+				return spilled.emplace_back(type);
 			}
-		}
-		Attribute(Attribute&& attribute) : value(attribute.value), type(attribute.type)
-		{
-			std::memset(&attribute.value, 0, sizeof(value));
-			attribute.type = ITEM_ATTRIBUTE_NONE;
-		}
-		~Attribute()
-		{
-			if (ItemAttributes::isStrAttrType(type)) {
-				delete value.string;
-			} else if (ItemAttributes::isCustomAttrType(type)) {
-				delete value.custom;
+
+			if (inlineCount < inlineAttributes.size()) {
+				return inlineAttributes[inlineCount++] = Attribute(type);
 			}
+
+			spilled.reserve(inlineAttributes.size() * 2);
+			spilled.assign(inlineAttributes.begin(), inlineAttributes.end());
+			inlineCount = 0;
+			return spilled.emplace_back(type);
 		}
-		Attribute& operator=(Attribute other)
+
+		void pop_back()
 		{
-			Attribute::swap(*this, other);
-			return *this;
+			if (isSpilled()) {
+				spilled.pop_back();
+			} else {
+				--inlineCount;
+			}
 		}
-		Attribute& operator=(Attribute&& other)
-		{
-			if (this != &other) {
-				if (ItemAttributes::isStrAttrType(type)) {
-					delete value.string;
-				} else if (ItemAttributes::isCustomAttrType(type)) {
-					delete value.custom;
-				}
 
-				value = other.value;
-				type = other.type;
+		bool isSpilled() const { return spilled.capacity() != 0; }
 
-				std::memset(&other.value, 0, sizeof(value));
-				other.type = ITEM_ATTRIBUTE_NONE;
-			}
-			return *this;
-		}
+	private:
+		Attribute* data() { return isSpilled() ? spilled.data() : inlineAttributes.data(); }
+		const Attribute* data() const { return isSpilled() ? spilled.data() : inlineAttributes.data(); }
 
-		static void swap(Attribute& first, Attribute& second)
-		{
-			std::swap(first.value, second.value);
-			std::swap(first.type, second.type);
-		}
+		std::array<Attribute, 2> inlineAttributes;
+		std::vector<Attribute> spilled;
+		uint8_t inlineCount = 0;
+	};
+
+	// storage that most items never use, allocated on first access
+	struct Extension
+	{
+		CustomAttributeMap custom;
+		std::map<CombatType_t, Reflect> reflect;
+		std::map<CombatType_t, uint16_t> boostPercent;
 	};
 
-	std::vector<Attribute> attributes;
+	AttributeList attributes;
+	// every string attribute packed into one block; short texts fit in the string's own buffer
+	std::string strings;
+	std::unique_ptr<Extension> extension;
 	uint32_t attributeBits = 0;
 
-	std::map<CombatType_t, Reflect> reflect;
-	std::map<CombatType_t, uint16_t> boostPercent;
+	static std::atomic<size_t> instances;
+
+	Extension& getExtension()
+	{
+		if (!extension) {
+			extension.reset(new Extension());
+		}
+		return *extension;
+	}
 
 	const Reflect& getReflect(CombatType_t combatType)
 	{
-		auto it = reflect.find(combatType);
-		return it != reflect.end() ? it->second : emptyReflect;
+		if (!extension) {
+			return emptyReflect;
+		}
+
+		auto it = extension->reflect.find(combatType);
+		return it != extension->reflect.end() ? it->second : emptyReflect;
 	}
 	int16_t getBoostPercent(CombatType_t combatType)
 	{
-		auto it = boostPercent.find(combatType);
-		return it != boostPercent.end() ? it->second : 0;
+		if (!extension) {
+			return 0;
+		}
+
+		auto it = extension->boostPercent.find(combatType);
+		return it != extension->boostPercent.end() ? it->second : 0;
 	}
 
 	std::string_view getStrAttr(itemAttrTypes type) const;
@@ -374,6 +408,7 @@ private:
 
 	const Attribute* getExistingAttr(itemAttrTypes type) const;
 	Attribute& getAttr(itemAttrTypes type);
+	void eraseString(Attribute& attr);
 
 	CustomAttributeMap* getCustomAttributeMap()
 	{
@@ -381,7 +416,7 @@ private:
 			return nullptr;
 		}
 
-		return getAttr(ITEM_ATTRIBUTE_CUSTOM).value.custom;
+		return &extension->custom;
 	}
 
 	template <typename R>
@@ -403,10 +438,10 @@ private:
 		if (hasAttribute(ITEM_ATTRIBUTE_CUSTOM)) {
 			removeCustomAttribute(key);
 		} else {
-			getAttr(ITEM_ATTRIBUTE_CUSTOM).value.custom = new CustomAttributeMap();
+			getAttr(ITEM_ATTRIBUTE_CUSTOM);
 		}
 		auto lowercaseKey = boost::algorithm::to_lower_copy(std::string{key});
-		getAttr(ITEM_ATTRIBUTE_CUSTOM).value.custom->emplace(lowercaseKey, value);
+		getExtension().custom.emplace(lowercaseKey, value);
 	}
 
 	void setCustomAttribute(std::string_view key, const CustomAttribute& value)
@@ -414,10 +449,10 @@ private:
 		if (hasAttribute(ITEM_ATTRIBUTE_CUSTOM)) {
 			removeCustomAttribute(key);
 		} else {
-			getAttr(ITEM_ATTRIBUTE_CUSTOM).value.custom = new CustomAttributeMap();
+			getAttr(ITEM_ATTRIBUTE_CUSTOM);
 		}
 		auto lowercaseKey = boost::algorithm::to_lower_copy(std::string{key});
-		getAttr(ITEM_ATTRIBUTE_CUSTOM).value.custom->emplace(lowercaseKey, value);
+		getExtension().custom.emplace(lowercaseKey, value);
 	}
 
 	const CustomAttribute* getCustomAttribute(int64_t key)
@@ -471,7 +506,7 @@ public:
 	static bool isStrAttrType(itemAttrTypes type) { return (type & stringAttributeTypes) == type; }
 	inline static bool isCustomAttrType(itemAttrTypes type) { return (type & ITEM_ATTRIBUTE_CUSTOM) == type; }
 
-	const std::vector<Attribute>& getList() const { return attributes; }
+	const AttributeList& getList() const { return attributes; }
 
 	friend class Item;
 };
@@ -495,6 +530,11 @@ public:
 	// non-assignable
 	Item& operator=(const Item&) = delete;
 
+	// items and every derived type are recycled through a size-classed pool
+	static void* operator new(size_t size);
+	static void operator delete(void* p, size_t size);
+	static PoolStatistics getPoolStatistics();
+
 	bool equals(const Item* otherItem) const;
 
 	Item* getItem() override final { return this; }
@@ -728,6 +768,7 @@ public:
 	void setID(uint16_t newid);
 
 	// Returns the player that is holding this item in his inventory
+	Player* getHoldingPlayer();
 	const Player* getHoldingPlayer() const;
 
 	WeaponType_t getWeaponType() const { return items[id].weaponType; }
@@ -795,10 +836,16 @@ public:
 	uint32_t getWorth() const;
 	LightInfo getLightInfo() const;
 
-	void setReflect(CombatType_t combatType, const Reflect& reflect) { getAttributes()->reflect[combatType] = reflect; }
+	void setReflect(CombatType_t combatType, const Reflect& reflect)
+	{
+		getAttributes()->getExtension().reflect[combatType] = reflect;
+	}
 	Reflect getReflect(CombatType_t combatType, bool total = true) const;
 
-	void setBoostPercent(CombatType_t combatType, uint16_t value) { getAttributes()->boostPercent[combatType] = value; }
+	void setBoostPercent(CombatType_t combatType, uint16_t value)
+	{
+		getAttributes()->getExtension().boostPercent[combatType] = value;
+	}
 	uint16_t getBoostPercent(CombatType_t combatType, bool total = true) const;
 
 	bool hasProperty(ITEMPROPERTY prop) const;
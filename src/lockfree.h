@@ -67,4 +67,74 @@ public:
 	}
 };
 
+struct PoolStatistics
+{
+	uint64_t allocations = 0; // blocks taken from the general heap
+	uint64_t reused = 0;      // allocations served from a free list
+	uint64_t released = 0;    // blocks handed back to the general heap because their free list was full
+	uint64_t live = 0;
+};
+
+/*
+ * Size-classed pool meant for class-level operator new/delete of a polymorphic
+ * hierarchy. Every derived type is served from the free list of its size rounded
+ * up to Granularity, so objects that are created and destroyed all the time (items,
+ * containers, tiles) recycle each other's memory instead of fragmenting the heap.
+ * Objects larger than Classes * Granularity bypass the pool.
+ */
+template <size_t Capacity, size_t Granularity = 16, size_t Classes = 16>
+class LockfreeObjectPool
+{
+public:
+	void* allocate(size_t size)
+	{
+		++live;
+		if (size > MaxSize) {
+			++allocations;
+			return operator new(size);
+		}
+
+		void* p;
+		if (freeLists[getSizeClass(size)].pop(p)) {
+			++reused;
+			return p;
+		}
+
+		++allocations;
+		return operator new(getSizeClass(size) * Granularity + Granularity);
+	}
+
+	void deallocate(void* p, size_t size)
+	{
+		--live;
+		if (size > MaxSize || !freeLists[getSizeClass(size)].bounded_push(p)) {
+			++released;
+			operator delete(p);
+		}
+	}
+
+	PoolStatistics getStatistics() const
+	{
+		PoolStatistics statistics;
+		statistics.allocations = allocations.load(std::memory_order_relaxed);
+		statistics.reused = reused.load(std::memory_order_relaxed);
+		statistics.released = released.load(std::memory_order_relaxed);
+		statistics.live = live.load(std::memory_order_relaxed);
+		return statistics;
+	}
+
+private:
+	static constexpr size_t MaxSize = Classes * Granularity;
+
+	static size_t getSizeClass(size_t size) { return (size - 1) / Granularity; }
+
+	using FreeList = boost::lockfree::stack<void*, boost::lockfree::capacity<Capacity>>;
+	std::array<FreeList, Classes> freeLists;
+
+	std::atomic<uint64_t> allocations{0};
+	std::atomic<uint64_t> reused{0};
+	std::atomic<uint64_t> released{0};
+	std::atomic<uint64_t> live{0};
+};
+
 #endif // FS_LOCKFREE_H
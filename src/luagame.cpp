@@ -3,9 +3,11 @@
 
 #include "otpch.h"
 
+#include "ban.h"
 #include "configmanager.h"
 #include "events.h"
 #include "game.h"
+#include "iologindata.h"
 #include "luascript.h"
 #include "monster.h"
 #include "monsters.h"
@@ -107,6 +109,98 @@ int luaGameGetMonsterCount(lua_State* L)
 	return 1;
 }
 
+int luaGameGetMonsterThinkLevels(lua_State* L)
+{
+	// Game.getMonsterThinkLevels()
+	std::array<uint32_t, MONSTER_THINK_LAST + 1> counts = {};
+	for (const auto& it : g_game.getMonsters()) {
+		++counts[it.second->getThinkLevel()];
+	}
+
+	lua_createtable(L, 0, 3);
+	setField(L, "full", counts[MONSTER_THINK_FULL]);
+	setField(L, "reduced", counts[MONSTER_THINK_REDUCED]);
+	setField(L, "dormant", counts[MONSTER_THINK_DORMANT]);
+	return 1;
+}
+
+int luaGameGetSpawnStatistics(lua_State* L)
+{
+	// Game.getSpawnStatistics()
+	const SpawnStatistics& statistics = g_game.map.spawns.getStatistics();
+	lua_createtable(L, 0, 4);
+	setField(L, "respawns", statistics.respawns);
+	setField(L, "blocked", statistics.blocked);
+	setField(L, "checks", statistics.checks);
+	setField(L, "checkTime", statistics.checkTime);
+	return 1;
+}
+
+void pushPoolStatistics(lua_State* L, const PoolStatistics& statistics)
+{
+	lua_createtable(L, 0, 4);
+	setField(L, "allocations", statistics.allocations);
+	setField(L, "reused", statistics.reused);
+	setField(L, "released", statistics.released);
+	setField(L, "live", statistics.live);
+}
+
+int luaGameGetPoolStatistics(lua_State* L)
+{
+	// Game.getPoolStatistics()
+	lua_createtable(L, 0, 2);
+	pushPoolStatistics(L, Item::getPoolStatistics());
+	lua_setfield(L, -2, "items");
+	pushPoolStatistics(L, Tile::getPoolStatistics());
+	lua_setfield(L, -2, "tiles");
+	return 1;
+}
+
+int luaGameGetLoginStatistics(lua_State* L)
+{
+	// Game.getLoginStatistics()
+	const LoginStatistics& statistics = g_game.getLoginStatistics();
+	lua_createtable(L, 0, 2);
+	setField(L, "logins", statistics.logins);
+
+	lua_createtable(L, statistics.dispatcherTime.size(), 0);
+	for (size_t i = 0; i < statistics.dispatcherTime.size(); ++i) {
+		lua_createtable(L, 0, 2);
+		if (i < LOGIN_TIME_LIMITS.size()) {
+			setField(L, "limit", LOGIN_TIME_LIMITS[i]);
+		}
+		setField(L, "count", statistics.dispatcherTime[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+	lua_setfield(L, -2, "dispatcherTime");
+	return 1;
+}
+
+int luaGameGetGuildStatistics(lua_State* L)
+{
+	// Game.getGuildStatistics()
+	const GuildStatistics& statistics = IOGuild::getStatistics();
+	lua_createtable(L, 0, 3);
+	setField(L, "lookups", statistics.lookups);
+	setField(L, "misses", statistics.misses);
+	setField(L, "reloads", statistics.reloads);
+	return 1;
+}
+
+int luaGameGetStorageStatistics(lua_State* L)
+{
+	// Game.getStorageStatistics()
+	const StorageStatistics& statistics = IOLoginData::getStorageStatistics();
+	lua_createtable(L, 0, 6);
+	setField(L, "updates", statistics.updates);
+	setField(L, "coalesced", statistics.coalesced);
+	setField(L, "flushes", statistics.flushes);
+	setField(L, "failedFlushes", statistics.failedFlushes);
+	setField(L, "rowsWritten", statistics.rowsWritten);
+	setField(L, "rowsDeleted", statistics.rowsDeleted);
+	return 1;
+}
+
 int luaGameGetPlayerCount(lua_State* L)
 {
 	// Game.getPlayerCount()
@@ -705,6 +799,75 @@ int luaGameSaveGameStorageValues(lua_State* L)
 
 	return 1;
 }
+
+int luaGameAddAccountBan(lua_State* L)
+{
+	// Game.addAccountBan(accountId, reason, expiresAt, bannedBy)
+	const Player* bannedBy = getPlayer(L, 4);
+	if (!bannedBy) {
+		reportErrorFunc(L, LuaScriptInterface::getErrorDesc(LuaErrorCode::PLAYER_NOT_FOUND));
+		pushBoolean(L, false);
+		return 1;
+	}
+
+	pushBoolean(L, IOBan::addAccountBan(getInteger<uint32_t>(L, 1), getString(L, 2), getInteger<time_t>(L, 3),
+	                                    bannedBy->getGUID(), bannedBy->getName()));
+	return 1;
+}
+
+int luaGameRemoveAccountBan(lua_State* L)
+{
+	// Game.removeAccountBan(accountId)
+	pushBoolean(L, IOBan::removeAccountBan(getInteger<uint32_t>(L, 1)));
+	return 1;
+}
+
+int luaGameIsAccountBanned(lua_State* L)
+{
+	// Game.isAccountBanned(accountId)
+	BanInfo banInfo;
+	pushBoolean(L, IOBan::isAccountBanned(getInteger<uint32_t>(L, 1), banInfo));
+	return 1;
+}
+
+int luaGameAddIpBan(lua_State* L)
+{
+	// Game.addIpBan(ip, reason, expiresAt, bannedBy)
+	const Player* bannedBy = getPlayer(L, 4);
+	if (!bannedBy) {
+		reportErrorFunc(L, LuaScriptInterface::getErrorDesc(LuaErrorCode::PLAYER_NOT_FOUND));
+		pushBoolean(L, false);
+		return 1;
+	}
+
+	pushBoolean(L, IOBan::addIpBan(getInteger<uint32_t>(L, 1), getString(L, 2), getInteger<time_t>(L, 3),
+	                               bannedBy->getGUID(), bannedBy->getName()));
+	return 1;
+}
+
+int luaGameRemoveIpBan(lua_State* L)
+{
+	// Game.removeIpBan(ip)
+	pushBoolean(L, IOBan::removeIpBan(getInteger<uint32_t>(L, 1)));
+	return 1;
+}
+
+int luaGameIsIpBanned(lua_State* L)
+{
+	// Game.isIpBanned(ip)
+	BanInfo banInfo;
+	pushBoolean(L, IOBan::isIpBanned(getInteger<uint32_t>(L, 1), banInfo));
+	return 1;
+}
+
+int luaGameIncreaseBankBalance(lua_State* L)
+{
+	// Game.increaseBankBalance(guid, amount)
+	// for characters that are not online, one that is logging in reads its balance again
+	IOLoginData::increaseBankBalance(getInteger<uint32_t>(L, 1), getInteger<uint64_t>(L, 2));
+	pushBoolean(L, true);
+	return 1;
+}
 } // namespace
 
 void LuaScriptInterface::registerGame()
@@ -719,6 +882,12 @@ void LuaScriptInterface::registerGame()
 	registerMethod("Game", "getExperienceStage", luaGameGetExperienceStage);
 	registerMethod("Game", "getExperienceForLevel", luaGameGetExperienceForLevel);
 	registerMethod("Game", "getMonsterCount", luaGameGetMonsterCount);
+	registerMethod("Game", "getMonsterThinkLevels", luaGameGetMonsterThinkLevels);
+	registerMethod("Game", "getSpawnStatistics", luaGameGetSpawnStatistics);
+	registerMethod("Game", "getPoolStatistics", luaGameGetPoolStatistics);
+	registerMethod("Game", "getLoginStatistics", luaGameGetLoginStatistics);
+	registerMethod("Game", "getStorageStatistics", luaGameGetStorageStatistics);
+	registerMethod("Game", "getGuildStatistics", luaGameGetGuildStatistics);
 	registerMethod("Game", "getPlayerCount", luaGameGetPlayerCount);
 	registerMethod("Game", "getNpcCount", luaGameGetNpcCount);
 	registerMethod("Game", "getMonsterTypes", luaGameGetMonsterTypes);
@@ -766,4 +935,13 @@ void LuaScriptInterface::registerGame()
 	registerMethod("Game", "getStorageValue", luaGameGetGameStorageValue);
 	registerMethod("Game", "setStorageValue", luaGameSetGameStorageValue);
 	registerMethod("Game", "saveStorageValues", luaGameSaveGameStorageValues);
+
+	registerMethod("Game", "addAccountBan", luaGameAddAccountBan);
+	registerMethod("Game", "removeAccountBan", luaGameRemoveAccountBan);
+	registerMethod("Game", "isAccountBanned", luaGameIsAccountBanned);
+	registerMethod("Game", "addIpBan", luaGameAddIpBan);
+	registerMethod("Game", "removeIpBan", luaGameRemoveIpBan);
+	registerMethod("Game", "isIpBanned", luaGameIsIpBanned);
+
+	registerMethod("Game", "increaseBankBalance", luaGameIncreaseBankBalance);
 }
@@ -469,7 +469,7 @@ int luaHouseKickPlayer(lua_State* L)
 int luaHouseSave(lua_State* L)
 {
 	// house:save()
-	const House* house = getUserdata<const House>(L, 1);
+	House* house = getUserdata<House>(L, 1);
 	if (!house) {
 		lua_pushnil(L);
 		return 1;
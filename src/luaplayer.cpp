@@ -97,6 +97,31 @@ int luaPlayerGetIp(lua_State* L)
 	return 1;
 }
 
+int luaPlayerGetConnectionStatistics(lua_State* L)
+{
+	// player:getConnectionStatistics()
+	const Player* player = getUserdata<const Player>(L, 1);
+	if (!player) {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	Connection_ptr connection = player->getConnection();
+	if (!connection) {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	const ConnectionStatistics statistics = connection->getStatistics();
+	lua_createtable(L, 0, 5);
+	setField(L, "writes", statistics.writes);
+	setField(L, "bytesWritten", statistics.bytesWritten);
+	setField(L, "messagesWritten", statistics.messagesWritten);
+	setField(L, "queueDepth", statistics.queueDepth);
+	setField(L, "maxQueueDepth", statistics.maxQueueDepth);
+	return 1;
+}
+
 int luaPlayerGetAccountId(lua_State* L)
 {
 	// player:getAccountId()
@@ -2283,6 +2308,7 @@ void LuaScriptInterface::registerPlayer()
 
 	registerMethod("Player", "getGuid", luaPlayerGetGuid);
 	registerMethod("Player", "getIp", luaPlayerGetIp);
+	registerMethod("Player", "getConnectionStatistics", luaPlayerGetConnectionStatistics);
 	registerMethod("Player", "getAccountId", luaPlayerGetAccountId);
 	registerMethod("Player", "getLastLoginSaved", luaPlayerGetLastLoginSaved);
 	registerMethod("Player", "getLastLogout", luaPlayerGetLastLogout);
@@ -27,6 +27,7 @@
 #include "teleport.h"
 
 #include <boost/range/adaptor/reversed.hpp>
+#include <charconv>
 
 extern Chat* g_chat;
 extern Game g_game;
@@ -2997,11 +2998,149 @@ int LuaScriptInterface::luaConfigManagerGetBoolean(lua_State* L)
 	return 1;
 }
 
+namespace {
+
+// synchronous db.query/db.storeQuery calls per script file, they block the dispatcher for a full round trip
+struct SyncQueryCount
+{
+	uint64_t count = 0;
+	bool warned = false;
+};
+
+std::map<std::string, SyncQueryCount, std::less<>> syncQueryCounts;
+
+void countSyncQuery(std::string_view function)
+{
+	ScriptEnvironment* env = LuaScriptInterface::getScriptEnv();
+	LuaScriptInterface* scriptInterface = env->getScriptInterface();
+	if (!scriptInterface) {
+		return;
+	}
+
+	std::string_view file = scriptInterface->getFileById(env->getScriptId());
+	auto it = syncQueryCounts.find(file);
+	if (it == syncQueryCounts.end()) {
+		it = syncQueryCounts.emplace(file, SyncQueryCount{}).first;
+	}
+
+	SyncQueryCount& queries = it->second;
+	++queries.count;
+
+	// queries while loading scripts are expected, warn once per file about the ones made while the game runs
+	if (!queries.warned && g_game.getGameState() == GAME_STATE_NORMAL) {
+		queries.warned = true;
+		std::cout << "[Warning - " << function << "] " << file
+		          << " blocks the game loop on a database query, consider db.awaitQuery/db.awaitStoreQuery."
+		          << std::endl;
+	}
+}
+
+int resumeThread(lua_State* thread, lua_State* from, int32_t nargs)
+{
+#if LUA_VERSION_NUM >= 504
+	int nresults;
+	return lua_resume(thread, from, nargs, &nresults);
+#elif LUA_VERSION_NUM >= 502
+	return lua_resume(thread, from, nargs);
+#else
+	(void)from;
+	return lua_resume(thread, nargs);
+#endif
+}
+
+void pushResultRows(lua_State* L, const DBResult_ptr& result)
+{
+	lua_newtable(L);
+	if (!result) {
+		return;
+	}
+
+	int32_t index = 0;
+	const auto& columns = result->getColumns();
+	do {
+		lua_createtable(L, 0, columns.size());
+		for (const auto& [name, column] : columns) {
+			auto value = result->getString(name);
+			if (!value.data()) {
+				continue;
+			}
+
+			int64_t integer;
+			if (result->isNumeric(column) &&
+			    std::from_chars(value.data(), value.data() + value.size(), integer).ptr == value.data() + value.size()) {
+				lua_pushinteger(L, integer);
+			} else if (result->isNumeric(column)) {
+				lua_pushnumber(L, std::stod(std::string{value}));
+			} else {
+				lua_pushlstring(L, value.data(), value.size());
+			}
+			lua_setfield(L, -2, std::string{name}.c_str());
+		}
+		lua_rawseti(L, -2, ++index);
+	} while (result->next());
+}
+
+// Suspends the calling coroutine until the database worker has run the query. The coroutine is resumed on the
+// dispatcher with whatever pushResults leaves on its stack.
+int awaitQuery(lua_State* L, const char* function, bool store,
+               void (*pushResults)(lua_State*, const DBResult_ptr&, bool))
+{
+	// raised before anything with a destructor lives on this frame
+	LuaScriptInterface* scriptInterface = LuaScriptInterface::getScriptEnv()->getScriptInterface();
+	if (!scriptInterface || scriptInterface->getLuaState() != g_luaEnvironment.getLuaState()) {
+		return luaL_error(L, "%s is not available to scripts with their own Lua state.", function);
+	}
+
+	if (lua_pushthread(L) == 1) {
+		lua_pop(L, 1);
+		return luaL_error(L, "%s has to be called from a coroutine, see db.async.", function);
+	}
+
+	std::string query = Lua::getString(L, 1);
+
+	// keeps the coroutine alive while the query runs
+	int32_t threadRef = luaL_ref(L, LUA_REGISTRYINDEX);
+	auto scriptId = LuaScriptInterface::getScriptEnv()->getScriptId();
+	g_databaseTasks.addTask(
+	    std::move(query),
+	    [threadRef, scriptId, pushResults](DBResult_ptr result, bool success) {
+		    lua_State* luaState = g_luaEnvironment.getLuaState();
+		    if (!luaState) {
+			    return;
+		    }
+
+		    lua_rawgeti(luaState, LUA_REGISTRYINDEX, threadRef);
+		    lua_State* thread = lua_tothread(luaState, -1);
+		    lua_pop(luaState, 1);
+		    if (!thread || !LuaScriptInterface::reserveScriptEnv()) {
+			    luaL_unref(luaState, LUA_REGISTRYINDEX, threadRef);
+			    return;
+		    }
+
+		    LuaScriptInterface::getScriptEnv()->setScriptId(scriptId, &g_luaEnvironment);
+		    pushResults(thread, result, success);
+		    int ret = resumeThread(thread, luaState, 1);
+		    if (ret != 0 && ret != LUA_YIELD) {
+			    LuaScriptInterface::reportError(nullptr, Lua::popString(thread), thread, true);
+		    }
+		    LuaScriptInterface::resetScriptEnv();
+
+		    luaL_unref(luaState, LUA_REGISTRYINDEX, threadRef);
+	    },
+	    store);
+	return lua_yield(L, 0);
+}
+
+} // namespace
+
 const luaL_Reg LuaScriptInterface::luaDatabaseTable[] = {
     {"query", LuaScriptInterface::luaDatabaseExecute},
     {"asyncQuery", LuaScriptInterface::luaDatabaseAsyncExecute},
     {"storeQuery", LuaScriptInterface::luaDatabaseStoreQuery},
     {"asyncStoreQuery", LuaScriptInterface::luaDatabaseAsyncStoreQuery},
+    {"awaitQuery", LuaScriptInterface::luaDatabaseAwaitQuery},
+    {"awaitStoreQuery", LuaScriptInterface::luaDatabaseAwaitStoreQuery},
+    {"getSyncQueryCounts", LuaScriptInterface::luaDatabaseGetSyncQueryCounts},
     {"escapeString", LuaScriptInterface::luaDatabaseEscapeString},
     {"escapeBlob", LuaScriptInterface::luaDatabaseEscapeBlob},
     {"lastInsertId", LuaScriptInterface::luaDatabaseLastInsertId},
@@ -3010,6 +3149,7 @@ const luaL_Reg LuaScriptInterface::luaDatabaseTable[] = {
 
 int LuaScriptInterface::luaDatabaseExecute(lua_State* L)
 {
+	countSyncQuery("db.query");
 	Lua::pushBoolean(L, Database::getInstance().executeQuery(Lua::getString(L, -1)));
 	return 1;
 }
@@ -3046,6 +3186,7 @@ int LuaScriptInterface::luaDatabaseAsyncExecute(lua_State* L)
 
 int LuaScriptInterface::luaDatabaseStoreQuery(lua_State* L)
 {
+	countSyncQuery("db.storeQuery");
 	if (DBResult_ptr res = Database::getInstance().storeQuery(Lua::getString(L, -1))) {
 		lua_pushinteger(L, ScriptEnvironment::addResult(res));
 	} else {
@@ -3088,6 +3229,36 @@ int LuaScriptInterface::luaDatabaseAsyncStoreQuery(lua_State* L)
 	return 0;
 }
 
+int LuaScriptInterface::luaDatabaseAwaitQuery(lua_State* L)
+{
+	// db.awaitQuery(query)
+	return awaitQuery(L, "db.awaitQuery", false,
+	                  [](lua_State* thread, const DBResult_ptr&, bool success) { Lua::pushBoolean(thread, success); });
+}
+
+int LuaScriptInterface::luaDatabaseAwaitStoreQuery(lua_State* L)
+{
+	// db.awaitStoreQuery(query)
+	return awaitQuery(L, "db.awaitStoreQuery", true, [](lua_State* thread, const DBResult_ptr& result, bool success) {
+		if (success) {
+			pushResultRows(thread, result);
+		} else {
+			Lua::pushBoolean(thread, false);
+		}
+	});
+}
+
+int LuaScriptInterface::luaDatabaseGetSyncQueryCounts(lua_State* L)
+{
+	// db.getSyncQueryCounts()
+	lua_createtable(L, 0, syncQueryCounts.size());
+	for (const auto& [file, queries] : syncQueryCounts) {
+		lua_pushinteger(L, queries.count);
+		lua_setfield(L, -2, file.c_str());
+	}
+	return 1;
+}
+
 int LuaScriptInterface::luaDatabaseEscapeString(lua_State* L)
 {
 	Lua::pushString(L, Database::getInstance().escapeString(Lua::getString(L, -1)));
@@ -320,7 +320,7 @@ public:
 	static std::string escapeString(std::string string);
 
 	static const luaL_Reg luaConfigManagerTable[4];
-	static const luaL_Reg luaDatabaseTable[9];
+	static const luaL_Reg luaDatabaseTable[12];
 	static const luaL_Reg luaResultTable[6];
 
 	static int protectedCall(lua_State* L, int nargs, int nresults);
@@ -446,6 +446,9 @@ private:
 	static int luaDatabaseAsyncExecute(lua_State* L);
 	static int luaDatabaseStoreQuery(lua_State* L);
 	static int luaDatabaseAsyncStoreQuery(lua_State* L);
+	static int luaDatabaseAwaitQuery(lua_State* L);
+	static int luaDatabaseAwaitStoreQuery(lua_State* L);
+	static int luaDatabaseGetSyncQueryCounts(lua_State* L);
 	static int luaDatabaseEscapeString(lua_State* L);
 	static int luaDatabaseEscapeBlob(lua_State* L);
 	static int luaDatabaseLastInsertId(lua_State* L);
@@ -335,9 +335,10 @@ void Map::moveCreature(Creature& creature, Tile& newTile, bool forceTeleport /*
 	newTile.postAddNotification(&creature, &oldTile, 0);
 }
 
-void Map::getSpectatorsInternal(SpectatorVec& spectators, const Position& centerPos, int32_t minRangeX,
-                                int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY, int32_t minRangeZ,
-                                int32_t maxRangeZ, bool onlyPlayers) const
+template <typename Visitor>
+bool Map::visitSpectators(const Position& centerPos, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY,
+                          int32_t maxRangeY, int32_t minRangeZ, int32_t maxRangeZ, bool onlyPlayers,
+                          Visitor&& visitor) const
 {
 	auto min_y = centerPos.y + minRangeY;
 	auto min_x = centerPos.x + minRangeX;
@@ -379,7 +380,9 @@ void Map::getSpectatorsInternal(SpectatorVec& spectators, const Position& center
 						continue;
 					}
 
-					spectators.emplace_back(creature);
+					if (visitor(creature)) {
+						return true;
+					}
 				}
 				leafE = leafE->leafE;
 			} else {
@@ -393,6 +396,28 @@ void Map::getSpectatorsInternal(SpectatorVec& spectators, const Position& center
 			leafS = QTreeNode::getLeafStatic<const QTreeLeafNode*, const QTreeNode*>(&root, startx1, ny + FLOOR_SIZE);
 		}
 	}
+	return false;
+}
+
+void Map::getSpectatorsInternal(SpectatorVec& spectators, const Position& centerPos, int32_t minRangeX,
+                                int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY, int32_t minRangeZ,
+                                int32_t maxRangeZ, bool onlyPlayers) const
+{
+	visitSpectators(centerPos, minRangeX, maxRangeX, minRangeY, maxRangeY, minRangeZ, maxRangeZ, onlyPlayers,
+	                [&spectators](Creature* creature) {
+		                spectators.emplace_back(creature);
+		                return false;
+	                });
+}
+
+bool Map::hasPlayerSpectator(const Position& centerPos, const std::function<bool(const Creature*)>& predicate) const
+{
+	if (centerPos.z >= MAP_MAX_LAYERS) {
+		return false;
+	}
+
+	return visitSpectators(centerPos, -maxViewportX, maxViewportX, -maxViewportY, maxViewportY, centerPos.z,
+	                       centerPos.z, true, predicate);
 }
 
 void Map::getSpectators(SpectatorVec& spectators, const Position& centerPos, bool multifloor /*= false*/,
@@ -210,6 +210,12 @@ public:
 	void clearSpectatorCache();
 	void clearPlayersSpectatorCache();
 
+	/**
+	 * Checks if any player in view of a position, on the same floor, matches the predicate.
+	 * Stops at the first match instead of collecting every spectator.
+	 */
+	bool hasPlayerSpectator(const Position& centerPos, const std::function<bool(const Creature*)>& predicate) const;
+
 	/**
 	 * Checks if you can throw an object to that position
 	 *	\param fromPos from Source point
@@ -269,6 +275,12 @@ private:
 	uint32_t width = 0;
 	uint32_t height = 0;
 
+	// Walks the map nodes in range, until the visitor returns true
+	template <typename Visitor>
+	bool visitSpectators(const Position& centerPos, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY,
+	                     int32_t maxRangeY, int32_t minRangeZ, int32_t maxRangeZ, bool onlyPlayers,
+	                     Visitor&& visitor) const;
+
 	// Actually scans the map for spectators
 	void getSpectatorsInternal(SpectatorVec& spectators, const Position& centerPos, int32_t minRangeX,
 	                           int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY, int32_t minRangeZ,
@@ -71,7 +71,9 @@ void Monster::setName(std::string_view name)
 		return;
 	}
 
+	const std::string oldName = getName();
 	this->name = name;
+	g_game.updateMonsterName(this, oldName);
 
 	// NOTE: Due to how client caches known creatures,
 	// it is not feasible to send creature update to everyone that has ever met it
@@ -227,7 +229,11 @@ void Monster::onCreatureMove(Creature* creature, const Tile* newTile, const Posi
 			isMasterInRange = canSee(getMaster()->getPosition());
 		}
 
-		updateTargetList();
+		if (teleport) {
+			updateTargetList();
+		} else {
+			updateTargetList(oldPos, newPos);
+		}
 		updateIdleStatus();
 	} else {
 		bool canSeeNewPos = canSee(newPos);
@@ -306,15 +312,15 @@ void Monster::onCreatureSay(Creature* creature, SpeakClasses type, std::string_v
 void Monster::addFriend(Creature* creature)
 {
 	assert(creature != this);
-	auto result = friendList.insert(creature);
-	if (result.second) {
+	if (std::find(friendList.begin(), friendList.end(), creature) == friendList.end()) {
 		creature->incrementReferenceCounter();
+		friendList.push_back(creature);
 	}
 }
 
 void Monster::removeFriend(Creature* creature)
 {
-	auto it = friendList.find(creature);
+	auto it = std::find(friendList.begin(), friendList.end(), creature);
 	if (it != friendList.end()) {
 		creature->decrementReferenceCounter();
 		friendList.erase(it);
@@ -327,7 +333,7 @@ void Monster::addTarget(Creature* creature, bool pushFront /* = false*/)
 	if (std::find(targetList.begin(), targetList.end(), creature) == targetList.end()) {
 		creature->incrementReferenceCounter();
 		if (pushFront) {
-			targetList.push_front(creature);
+			targetList.insert(targetList.begin(), creature);
 		} else {
 			targetList.push_back(creature);
 		}
@@ -343,32 +349,57 @@ void Monster::removeTarget(Creature* creature)
 	}
 }
 
-void Monster::updateTargetList()
+void Monster::removeUnseenTargets()
 {
-	auto friendIterator = friendList.begin();
-	while (friendIterator != friendList.end()) {
-		Creature* creature = *friendIterator;
+	auto isGone = [this](Creature* creature) {
 		if (creature->isDead() || !canSee(creature->getPosition())) {
 			creature->decrementReferenceCounter();
-			friendIterator = friendList.erase(friendIterator);
-		} else {
-			++friendIterator;
+			return true;
 		}
+		return false;
+	};
+	std::erase_if(friendList, isGone);
+	std::erase_if(targetList, isGone);
+}
+
+void Monster::updateTargetList()
+{
+	removeUnseenTargets();
+
+	SpectatorVec spectators;
+	g_game.map.getSpectators(spectators, position, true);
+	spectators.erase(this);
+	for (Creature* spectator : spectators) {
+		onCreatureFound(spectator);
 	}
+}
 
-	auto targetIterator = targetList.begin();
-	while (targetIterator != targetList.end()) {
-		Creature* creature = *targetIterator;
-		if (creature->isDead() || !canSee(creature->getPosition())) {
-			creature->decrementReferenceCounter();
-			targetIterator = targetList.erase(targetIterator);
-		} else {
-			++targetIterator;
-		}
+void Monster::updateTargetList(const Position& oldPos, const Position& newPos)
+{
+	const int32_t stepX = newPos.getOffsetX(oldPos);
+	const int32_t stepY = newPos.getOffsetY(oldPos);
+	if (oldPos.z != newPos.z || std::abs(stepX) > 1 || std::abs(stepY) > 1) {
+		updateTargetList();
+		return;
 	}
 
+	removeUnseenTargets();
+
+	// creatures already in sight were found before, and everyone that moves into our view notifies us, so after a
+	// single step only the row and column that just came into view have to be searched
+	constexpr int32_t viewRange = Map::maxClientViewportX + 1;
+
 	SpectatorVec spectators;
-	g_game.map.getSpectators(spectators, position, true);
+	if (stepX != 0) {
+		const int32_t edgeX = stepX > 0 ? viewRange : -viewRange;
+		g_game.map.getSpectators(spectators, newPos, true, false, -edgeX, edgeX, viewRange, viewRange);
+	}
+
+	if (stepY != 0) {
+		const int32_t edgeY = stepY > 0 ? viewRange : -viewRange;
+		g_game.map.getSpectators(spectators, newPos, true, false, viewRange, viewRange, -edgeY, edgeY);
+	}
+
 	spectators.erase(this);
 	for (Creature* spectator : spectators) {
 		onCreatureFound(spectator);
@@ -496,7 +527,7 @@ void Monster::onCreatureLeave(Creature* creature)
 
 bool Monster::searchTarget(TargetSearchType_t searchType /*= TARGETSEARCH_DEFAULT*/)
 {
-	std::list<Creature*> resultList;
+	CreatureVector resultList;
 	const Position& myPos = getPosition();
 
 	for (Creature* creature : targetList) {
@@ -579,15 +610,13 @@ void Monster::onFollowCreatureComplete(const Creature* creature)
 	if (creature) {
 		auto it = std::find(targetList.begin(), targetList.end(), creature);
 		if (it != targetList.end()) {
-			Creature* target = (*it);
-			targetList.erase(it);
-
 			if (hasFollowPath) {
-				targetList.push_front(target);
+				std::rotate(targetList.begin(), it, it + 1);
 			} else if (!isSummon()) {
-				targetList.push_back(target);
+				std::rotate(it, it + 1, targetList.end());
 			} else {
-				target->decrementReferenceCounter();
+				(*it)->decrementReferenceCounter();
+				targetList.erase(it);
 			}
 		}
 	}
@@ -660,8 +689,14 @@ void Monster::setIdle(bool idle)
 	isIdle = idle;
 
 	if (!isIdle) {
+		if (thinkLevel == MONSTER_THINK_DORMANT) {
+			// woken up by a creature coming into view, react right away
+			thinkLevel = MONSTER_THINK_FULL;
+			thinkTicks = 0;
+		}
 		g_game.addCreatureCheck(this);
 	} else {
+		thinkLevel = MONSTER_THINK_DORMANT;
 		onIdleStatus();
 		clearTargetList();
 		clearFriendList();
@@ -681,6 +716,31 @@ void Monster::updateIdleStatus()
 	setIdle(idle);
 }
 
+void Monster::updateThinkLevel()
+{
+	if (isIdle) {
+		thinkLevel = MONSTER_THINK_DORMANT;
+		return;
+	}
+
+	if (!getBoolean(ConfigManager::MONSTER_THINK_LOD) || isSummon() || targetList.empty()) {
+		thinkLevel = MONSTER_THINK_FULL;
+		return;
+	}
+
+	const int32_t fullThinkRange = getInteger(ConfigManager::MONSTER_FULL_THINK_RANGE);
+	const Position& myPos = getPosition();
+	for (const Creature* creature : targetList) {
+		const Position& pos = creature->getPosition();
+		if (pos.z == myPos.z && myPos.getDistanceX(pos) <= fullThinkRange &&
+		    myPos.getDistanceY(pos) <= fullThinkRange) {
+			thinkLevel = MONSTER_THINK_FULL;
+			return;
+		}
+	}
+	thinkLevel = MONSTER_THINK_REDUCED;
+}
+
 void Monster::onAddCondition(ConditionType_t type)
 {
 	if (type == CONDITION_FIRE || type == CONDITION_ENERGY || type == CONDITION_POISON) {
@@ -742,6 +802,18 @@ void Monster::onThink(uint32_t interval)
 		if (!isIdle) {
 			addEventWalk();
 
+			updateThinkLevel();
+
+			thinkTicks += interval;
+			if (thinkLevel == MONSTER_THINK_REDUCED &&
+			    thinkTicks < getInteger(ConfigManager::MONSTER_REDUCED_THINK_INTERVAL)) {
+				return;
+			}
+
+			// catch up on the ticks skipped while thinking at a reduced rate
+			interval = thinkTicks;
+			thinkTicks = 0;
+
 			if (isSummon()) {
 				if (!attackedCreature) {
 					if (getMaster() && getMaster()->getAttackedCreature()) {
@@ -11,9 +11,6 @@ class Creature;
 class Game;
 class Spawn;
 
-using CreatureHashSet = std::unordered_set<Creature*>;
-using CreatureList = std::list<Creature*>;
-
 enum TargetSearchType_t
 {
 	TARGETSEARCH_DEFAULT,
@@ -22,6 +19,15 @@ enum TargetSearchType_t
 	TARGETSEARCH_NEAREST,
 };
 
+enum MonsterThinkLevel_t : uint8_t
+{
+	MONSTER_THINK_FULL,
+	MONSTER_THINK_REDUCED,
+	MONSTER_THINK_DORMANT,
+
+	MONSTER_THINK_LAST = MONSTER_THINK_DORMANT,
+};
+
 class Monster final : public Creature
 {
 public:
@@ -110,8 +116,8 @@ public:
 	bool searchTarget(TargetSearchType_t searchType = TARGETSEARCH_DEFAULT);
 	bool selectTarget(Creature* creature);
 
-	const CreatureList& getTargetList() const { return targetList; }
-	const CreatureHashSet& getFriendList() const { return friendList; }
+	const CreatureVector& getTargetList() const { return targetList; }
+	const CreatureVector& getFriendList() const { return friendList; }
 
 	bool isTarget(const Creature* creature) const;
 	bool isFleeing() const
@@ -136,6 +142,8 @@ public:
 	bool getIdleStatus() const { return isIdle; }
 	void setIdle(bool idle);
 
+	MonsterThinkLevel_t getThinkLevel() const { return thinkLevel; }
+
 	bool isFriend(const Creature* creature) const;
 	bool isOpponent(const Creature* creature) const;
 
@@ -145,8 +153,8 @@ public:
 	void removeTarget(Creature* creature);
 
 private:
-	CreatureHashSet friendList;
-	CreatureList targetList;
+	CreatureVector friendList;
+	CreatureVector targetList;
 
 	std::string name;
 	std::string nameDescription;
@@ -165,9 +173,12 @@ private:
 	int32_t targetChangeCooldown = 0;
 	int32_t challengeFocusDuration = 0;
 	int32_t stepDuration = 0;
+	uint32_t thinkTicks = 0;
 
 	Position masterPos;
 
+	MonsterThinkLevel_t thinkLevel = MONSTER_THINK_DORMANT;
+
 	bool ignoreFieldDamage = false;
 	bool isIdle = true;
 	bool isMasterInRange = false;
@@ -180,7 +191,9 @@ private:
 
 	void updateLookDirection();
 
+	void removeUnseenTargets();
 	void updateTargetList();
+	void updateTargetList(const Position& oldPos, const Position& newPos);
 	void clearTargetList();
 	void clearFriendList();
 
@@ -188,6 +201,7 @@ private:
 	Item* getCorpse(Creature* lastHitCreature, Creature* mostDamageCreature) override;
 
 	void updateIdleStatus();
+	void updateThinkLevel();
 
 	void onAddCondition(ConditionType_t type) override;
 	void onEndCondition(ConditionType_t type) override;
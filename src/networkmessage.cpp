@@ -7,6 +7,100 @@
 
 #include "container.h"
 #include "creature.h"
+#include "lockfree.h"
+
+namespace {
+
+// most packets are tens of bytes, map descriptions and containers need the larger classes
+constexpr size_t NETWORKMESSAGE_SMALL_SIZE = NetworkMessage::MIN_BUFFER_SIZE;
+constexpr size_t NETWORKMESSAGE_MEDIUM_SIZE = 8192;
+constexpr size_t NETWORKMESSAGE_LARGE_SIZE = NETWORKMESSAGE_MAXSIZE;
+
+using SmallBufferList = LockfreeFreeList<NETWORKMESSAGE_SMALL_SIZE, 4096>;
+using MediumBufferList = LockfreeFreeList<NETWORKMESSAGE_MEDIUM_SIZE, 512>;
+using LargeBufferList = LockfreeFreeList<NETWORKMESSAGE_LARGE_SIZE, 128>;
+
+template <typename FreeList, size_t Size>
+uint8_t* popBuffer()
+{
+	void* p;
+	if (!FreeList::get().pop(p)) {
+		// uninitialised on purpose
+		p = operator new(Size);
+	}
+	return static_cast<uint8_t*>(p);
+}
+
+template <typename FreeList>
+void pushBuffer(uint8_t* buffer)
+{
+	if (!FreeList::get().bounded_push(buffer)) {
+		operator delete(buffer);
+	}
+}
+
+} // namespace
+
+uint8_t* NetworkMessage::acquireBuffer(MsgSize_t& capacity, size_t size /* = 0*/)
+{
+	if (size <= NETWORKMESSAGE_SMALL_SIZE) {
+		capacity = NETWORKMESSAGE_SMALL_SIZE;
+		return popBuffer<SmallBufferList, NETWORKMESSAGE_SMALL_SIZE>();
+	} else if (size <= NETWORKMESSAGE_MEDIUM_SIZE) {
+		capacity = NETWORKMESSAGE_MEDIUM_SIZE;
+		return popBuffer<MediumBufferList, NETWORKMESSAGE_MEDIUM_SIZE>();
+	}
+
+	capacity = NETWORKMESSAGE_LARGE_SIZE;
+	return popBuffer<LargeBufferList, NETWORKMESSAGE_LARGE_SIZE>();
+}
+
+void NetworkMessage::releaseBuffer(uint8_t* buffer, MsgSize_t capacity)
+{
+	switch (capacity) {
+		case NETWORKMESSAGE_SMALL_SIZE:
+			pushBuffer<SmallBufferList>(buffer);
+			break;
+		case NETWORKMESSAGE_MEDIUM_SIZE:
+			pushBuffer<MediumBufferList>(buffer);
+			break;
+		default:
+			pushBuffer<LargeBufferList>(buffer);
+			break;
+	}
+}
+
+bool NetworkMessage::grow(size_t size)
+{
+	if (size > NETWORKMESSAGE_MAXSIZE) {
+		return false;
+	}
+
+	MsgSize_t newCapacity;
+	uint8_t* newBuffer = acquireBuffer(newCapacity, size);
+	std::memcpy(newBuffer, buffer, getUsedSize());
+	releaseBuffer(buffer, capacity);
+
+	buffer = newBuffer;
+	capacity = newCapacity;
+	return true;
+}
+
+NetworkMessage::NetworkMessage(const NetworkMessage& other) : info(other.info)
+{
+	buffer = acquireBuffer(capacity, other.getUsedSize());
+	std::memcpy(buffer, other.buffer, other.getUsedSize());
+}
+
+NetworkMessage& NetworkMessage::operator=(const NetworkMessage& other)
+{
+	if (this != &other) {
+		reserve(other.getUsedSize());
+		std::memcpy(buffer, other.buffer, other.getUsedSize());
+		info = other.info;
+	}
+	return *this;
+}
 
 std::string_view NetworkMessage::getString(uint16_t stringLen /* = 0*/)
 {
@@ -18,7 +112,7 @@ std::string_view NetworkMessage::getString(uint16_t stringLen /* = 0*/)
 		return "";
 	}
 
-	auto it = buffer.data() + info.position;
+	auto it = buffer + info.position;
 	info.position += stringLen;
 	return {reinterpret_cast<char*>(it), stringLen};
 }
@@ -40,7 +134,7 @@ void NetworkMessage::addString(std::string_view value)
 	}
 
 	add<uint16_t>(stringLen);
-	std::memcpy(buffer.data() + info.position, value.data(), stringLen);
+	std::memcpy(buffer + info.position, value.data(), stringLen);
 	info.position += stringLen;
 	info.length += stringLen;
 }
@@ -58,7 +152,7 @@ void NetworkMessage::addBytes(const char* bytes, size_t size)
 		return;
 	}
 
-	std::memcpy(buffer.data() + info.position, bytes, size);
+	std::memcpy(buffer + info.position, bytes, size);
 	info.position += size;
 	info.length += size;
 }
@@ -69,7 +163,7 @@ void NetworkMessage::addPaddingBytes(size_t n)
 		return;
 	}
 
-	std::fill_n(buffer.data() + info.position, n, 0x33);
+	std::fill_n(buffer + info.position, n, 0x33);
 	info.length += n;
 }
 
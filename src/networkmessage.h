@@ -41,11 +41,27 @@ public:
 	{
 		MAX_PROTOCOL_BODY_LENGTH = MAX_BODY_LENGTH - 10
 	};
+	// the smallest pooled buffer size class
+	static constexpr MsgSize_t MIN_BUFFER_SIZE = 1024;
 
-	NetworkMessage() = default;
+	// the buffer starts in the smallest size class and grows on demand up to NETWORKMESSAGE_MAXSIZE
+	NetworkMessage() : buffer(acquireBuffer(capacity)) {}
+	~NetworkMessage() { releaseBuffer(buffer, capacity); }
+
+	NetworkMessage(const NetworkMessage& other);
+	NetworkMessage& operator=(const NetworkMessage& other);
 
 	void reset() { info = {}; }
 
+	// makes room for size bytes without losing the current contents, fails beyond NETWORKMESSAGE_MAXSIZE
+	bool reserve(size_t size)
+	{
+		if (size <= capacity) {
+			return true;
+		}
+		return grow(size);
+	}
+
 	// simply read functions for incoming message
 	uint8_t getByte()
 	{
@@ -68,7 +84,7 @@ public:
 		}
 
 		T value;
-		std::memcpy(&value, buffer.data() + info.position, sizeof(T));
+		std::memcpy(&value, buffer + info.position, sizeof(T));
 		info.position += sizeof(T);
 		return value;
 	}
@@ -97,7 +113,7 @@ public:
 			return;
 		}
 
-		std::memcpy(buffer.data() + info.position, &value, sizeof(T));
+		std::memcpy(buffer + info.position, &value, sizeof(T));
 		info.position += sizeof(T);
 		info.length += sizeof(T);
 	}
@@ -125,13 +141,16 @@ public:
 
 	bool setBufferPosition(MsgSize_t pos)
 	{
-		if (pos < NETWORKMESSAGE_MAXSIZE - INITIAL_BUFFER_POSITION) {
+		if (pos < NETWORKMESSAGE_MAXSIZE - INITIAL_BUFFER_POSITION && reserve(pos + INITIAL_BUFFER_POSITION)) {
 			info.position = pos + INITIAL_BUFFER_POSITION;
 			return true;
 		}
 		return false;
 	}
 
+	// received packets are read from just past their length header
+	void setBodyPosition() { info.position = HEADER_LENGTH; }
+
 	uint16_t getLengthHeader() const { return static_cast<uint16_t>(buffer[0] | buffer[1] << 8); }
 
 	bool isOverrun() const { return info.overrun; }
@@ -147,6 +166,10 @@ public:
 
 	uint8_t* getRemainingBuffer() { return &buffer[0] + info.position; }
 
+	// pooled buffer of the smallest size class holding size bytes, capacity receives its actual size
+	static uint8_t* acquireBuffer(MsgSize_t& capacity, size_t size = 0);
+	static void releaseBuffer(uint8_t* buffer, MsgSize_t capacity);
+
 protected:
 	struct NetworkMessageInfo
 	{
@@ -156,14 +179,28 @@ protected:
 	};
 
 	NetworkMessageInfo info = {};
-	std::array<uint8_t, NETWORKMESSAGE_MAXSIZE> buffer = {};
+	MsgSize_t capacity = 0;
+	// not zero-filled, only bytes that were written are ever sent
+	uint8_t* buffer;
 
 private:
-	bool canAdd(size_t size) const { return (size + info.position) < MAX_BODY_LENGTH; }
+	bool grow(size_t size);
+
+	// bytes that may hold message data: the headers, the body and anything read or written so far
+	size_t getUsedSize() const
+	{
+		return std::min<size_t>(capacity, std::max<size_t>(info.position, info.length + INITIAL_BUFFER_POSITION));
+	}
+
+	bool canAdd(size_t size)
+	{
+		size += info.position;
+		return size < MAX_BODY_LENGTH && reserve(size);
+	}
 
 	bool canRead(int32_t size)
 	{
-		if ((info.position + size) > (info.length + 8) || size >= (NETWORKMESSAGE_MAXSIZE - info.position)) {
+		if ((info.position + size) > (info.length + 8) || size >= (capacity - info.position)) {
 			info.overrun = true;
 			return false;
 		}
@@ -77,8 +77,12 @@ void Npc::reset()
 
 void Npc::reload()
 {
+	const std::string oldName = name;
 	reset();
 	load();
+	if (name != oldName) {
+		g_game.updateNpcName(this, oldName);
+	}
 
 	SpectatorVec players;
 	g_game.map.getSpectators(players, getPosition(), true, true);
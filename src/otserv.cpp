@@ -5,6 +5,7 @@
 
 #include "otserv.h"
 
+#include "ban.h"
 #include "configmanager.h"
 #include "databasemanager.h"
 #include "databasetasks.h"
@@ -131,6 +132,17 @@ void mainLoader(ServiceManager* services)
 		std::cout << "> No tables were optimized." << std::endl;
 	}
 
+	std::cout << ">> Loading bans" << std::endl;
+	if (!IOBan::loadBans(Database::getInstance())) {
+		startupErrorMessage("Unable to load bans!");
+		return;
+	}
+	IOBan::reloadBans();
+
+	std::cout << ">> Loading guilds" << std::endl;
+	IOGuild::loadGuilds(Database::getInstance());
+	IOGuild::reloadGuilds();
+
 	// load vocations
 	std::cout << ">> Loading vocations" << std::endl;
 	if (!g_vocations.loadFromXml()) {
@@ -7,57 +7,56 @@
 
 #include "lockfree.h"
 #include "protocol.h"
-#include "scheduler.h"
-
-extern Scheduler g_scheduler;
 
 namespace {
 
 const uint16_t OUTPUTMESSAGE_FREE_LIST_CAPACITY = 2048;
-const std::chrono::milliseconds OUTPUTMESSAGE_AUTOSEND_DELAY{10};
 
-void sendAll(const std::vector<Protocol_ptr>& bufferedProtocols);
+} // namespace
 
-void scheduleSendAll(const std::vector<Protocol_ptr>& bufferedProtocols)
+void OutputMessagePool::addProtocolToAutosend(Protocol_ptr protocol)
 {
-	g_scheduler.addEvent(
-	    createSchedulerTask(OUTPUTMESSAGE_AUTOSEND_DELAY.count(), [&]() { sendAll(bufferedProtocols); }));
+	// dispatcher thread
+	protocol->autosend = true;
+	if (protocol->getCurrentBuffer() && !protocol->autosendPending) {
+		addPendingProtocol(std::move(protocol));
+	}
 }
 
-void sendAll(const std::vector<Protocol_ptr>& bufferedProtocols)
+void OutputMessagePool::removeProtocolFromAutosend(const Protocol_ptr& protocol)
 {
 	// dispatcher thread
-	for (auto& protocol : bufferedProtocols) {
-		auto& msg = protocol->getCurrentBuffer();
-		if (msg) {
-			protocol->send(std::move(msg));
-		}
+	protocol->autosend = false;
+	if (!protocol->autosendPending) {
+		return;
 	}
 
-	if (!bufferedProtocols.empty()) {
-		scheduleSendAll(bufferedProtocols);
+	protocol->autosendPending = false;
+	auto it = std::find(pendingProtocols.begin(), pendingProtocols.end(), protocol);
+	if (it != pendingProtocols.end()) {
+		std::swap(*it, pendingProtocols.back());
+		pendingProtocols.pop_back();
 	}
 }
 
-} // namespace
-
-void OutputMessagePool::addProtocolToAutosend(Protocol_ptr protocol)
+void OutputMessagePool::addPendingProtocol(Protocol_ptr protocol)
 {
 	// dispatcher thread
-	if (bufferedProtocols.empty()) {
-		scheduleSendAll(bufferedProtocols);
-	}
-	bufferedProtocols.emplace_back(protocol);
+	protocol->autosendPending = true;
+	pendingProtocols.emplace_back(std::move(protocol));
 }
 
-void OutputMessagePool::removeProtocolFromAutosend(const Protocol_ptr& protocol)
+void OutputMessagePool::sendAll()
 {
 	// dispatcher thread
-	auto it = std::find(bufferedProtocols.begin(), bufferedProtocols.end(), protocol);
-	if (it != bufferedProtocols.end()) {
-		std::swap(*it, bufferedProtocols.back());
-		bufferedProtocols.pop_back();
+	for (auto& protocol : pendingProtocols) {
+		protocol->autosendPending = false;
+		auto& msg = protocol->getCurrentBuffer();
+		if (msg) {
+			protocol->send(std::move(msg));
+		}
 	}
+	pendingProtocols.clear();
 }
 
 OutputMessage_ptr OutputMessagePool::getOutputMessage()
@@ -8,6 +8,11 @@
 #include "networkmessage.h"
 #include "tools.h"
 
+// a buffer this full is sent right away instead of waiting for the end of the dispatcher batch, which also keeps it
+// within the medium buffer size class
+inline constexpr int32_t OUTPUTMESSAGE_FLUSH_THRESHOLD =
+    std::min<int32_t>(8 * 1024 - 16, NetworkMessage::MAX_PROTOCOL_BODY_LENGTH);
+
 class OutputMessage : public NetworkMessage
 {
 public:
@@ -33,7 +38,11 @@ public:
 	void append(const NetworkMessage& msg)
 	{
 		auto msgLen = msg.getLength();
-		std::memcpy(buffer.data() + info.position, msg.getBuffer() + 8, msgLen);
+		if (!reserve(info.position + msgLen)) {
+			return;
+		}
+
+		std::memcpy(buffer + info.position, msg.getBuffer() + 8, msgLen);
 		info.length += msgLen;
 		info.position += msgLen;
 	}
@@ -41,7 +50,11 @@ public:
 	void append(const OutputMessage_ptr& msg)
 	{
 		auto msgLen = msg->getLength();
-		std::memcpy(buffer.data() + info.position, msg->getBuffer() + 8, msgLen);
+		if (!reserve(info.position + msgLen)) {
+			return;
+		}
+
+		std::memcpy(buffer + info.position, msg->getBuffer() + 8, msgLen);
 		info.length += msgLen;
 		info.position += msgLen;
 	}
@@ -52,7 +65,7 @@ private:
 	{
 		assert(outputBufferStart >= sizeof(T));
 		outputBufferStart -= sizeof(T);
-		std::memcpy(buffer.data() + outputBufferStart, &add, sizeof(T));
+		std::memcpy(buffer + outputBufferStart, &add, sizeof(T));
 		// added header size to the message size
 		info.length += sizeof(T);
 	}
@@ -77,12 +90,15 @@ public:
 
 	void addProtocolToAutosend(Protocol_ptr protocol);
 	void removeProtocolFromAutosend(const Protocol_ptr& protocol);
+	void addPendingProtocol(Protocol_ptr protocol);
+
+	// sends the buffered output of every protocol that wrote something, called at the end of each dispatcher batch
+	void sendAll();
 
 private:
 	OutputMessagePool() = default;
-	// NOTE: A vector is used here because this container is mostly read and relatively rarely modified (only when a
-	// client connects/disconnects)
-	std::vector<Protocol_ptr> bufferedProtocols;
+	// only protocols holding unsent output, so idle clients cost nothing per flush
+	std::vector<Protocol_ptr> pendingProtocols;
 };
 
 #endif // FS_OUTPUTMESSAGE_H
@@ -629,6 +629,12 @@ uint16_t Player::getLookCorpse() const
 void Player::setStorageValue(const uint32_t key, const std::optional<int64_t> value, const bool isSpawn /* = false*/)
 {
 	Creature::setStorageValue(key, value, isSpawn);
+
+	// values read at login are already stored, everything else is written back by the next storage flush
+	if (!isSpawn) {
+		storageChanges.insert_or_assign(key, getStorageValue(key));
+		++storageUpdates;
+	}
 }
 
 bool Player::canSee(const Position& pos) const
@@ -1871,6 +1877,15 @@ uint32_t Player::getIP() const
 	return 0;
 }
 
+Connection_ptr Player::getConnection() const
+{
+	if (client) {
+		return client->getConnection();
+	}
+
+	return nullptr;
+}
+
 void Player::death(Creature* lastHitCreature)
 {
 	loginPosition = town->getTemplePosition();
@@ -2663,6 +2678,7 @@ void Player::addThing(int32_t index, Thing* thing)
 
 	item->setParent(this);
 	inventory[index] = item;
+	addItemTypeCounts(item, 1);
 
 	// send to client
 	sendInventoryItem(static_cast<slots_t>(index), item);
@@ -2680,8 +2696,10 @@ void Player::updateThing(Thing* thing, uint16_t itemId, uint32_t count)
 		return /*RETURNVALUE_NOTPOSSIBLE*/;
 	}
 
+	addItemTypeCount(item->getID(), -item->getItemCount());
 	item->setID(itemId);
 	item->setSubType(static_cast<uint16_t>(count));
+	addItemTypeCount(item->getID(), item->getItemCount());
 
 	// send to client
 	sendInventoryItem(static_cast<slots_t>(index), item);
@@ -2715,6 +2733,8 @@ void Player::replaceThing(uint32_t index, Thing* thing)
 	item->setParent(this);
 
 	inventory[index] = item;
+	addItemTypeCounts(oldItem, -1);
+	addItemTypeCounts(item, 1);
 }
 
 void Player::removeThing(Thing* thing, uint32_t count)
@@ -2739,8 +2759,10 @@ void Player::removeThing(Thing* thing, uint32_t count)
 
 			item->setParent(nullptr);
 			inventory[index] = nullptr;
+			addItemTypeCounts(item, -1);
 		} else {
 			uint8_t newCount = static_cast<uint8_t>(std::max<int32_t>(0, item->getItemCount() - count));
+			addItemTypeCount(item->getID(), newCount - item->getItemCount());
 			item->setItemCount(newCount);
 
 			// send change to client
@@ -2758,6 +2780,7 @@ void Player::removeThing(Thing* thing, uint32_t count)
 
 		item->setParent(nullptr);
 		inventory[index] = nullptr;
+		addItemTypeCounts(item, -1);
 	}
 }
 
@@ -2776,6 +2799,19 @@ size_t Player::getFirstIndex() const { return CONST_SLOT_FIRST; }
 size_t Player::getLastIndex() const { return CONST_SLOT_LAST + 1; }
 
 uint32_t Player::getItemTypeCount(uint16_t itemId, int32_t subType /*= -1*/) const
+{
+	if (subType != -1) {
+		return countItemsOfType(itemId, subType);
+	}
+
+	const auto& counts = getItemTypeCounts();
+	auto it = counts.find(itemId);
+	uint32_t count = it != counts.end() ? it->second : 0;
+	assert(count == countItemsOfType(itemId, -1));
+	return count;
+}
+
+uint32_t Player::countItemsOfType(uint16_t itemId, int32_t subType) const
 {
 	uint32_t count = 0;
 	for (int32_t i = CONST_SLOT_FIRST; i <= CONST_SLOT_LAST; i++) {
@@ -2799,12 +2835,72 @@ uint32_t Player::getItemTypeCount(uint16_t itemId, int32_t subType /*= -1*/) con
 	return count;
 }
 
+void Player::addItemTypeCount(uint16_t itemId, int32_t delta)
+{
+	if (!itemTypeCountsValid || delta == 0) {
+		return;
+	}
+
+	auto it = itemTypeCounts.try_emplace(itemId, 0).first;
+	assert(delta > 0 || it->second >= static_cast<uint32_t>(-delta));
+	it->second += delta;
+	if (it->second == 0) {
+		itemTypeCounts.erase(it);
+	}
+}
+
+void Player::addItemTypeCounts(const Item* item, int32_t sign)
+{
+	if (!itemTypeCountsValid) {
+		return;
+	}
+
+	addItemTypeCount(item->getID(), sign * item->getItemCount());
+
+	if (const Container* container = item->getContainer()) {
+		for (ContainerIterator it = container->iterator(); it.hasNext(); it.advance()) {
+			addItemTypeCount((*it)->getID(), sign * (*it)->getItemCount());
+		}
+	}
+}
+
+const std::unordered_map<uint16_t, uint32_t>& Player::getItemTypeCounts() const
+{
+	if (itemTypeCountsValid) {
+		return itemTypeCounts;
+	}
+
+	itemTypeCounts.clear();
+	for (int32_t i = CONST_SLOT_FIRST; i <= CONST_SLOT_LAST; i++) {
+		Item* item = inventory[i];
+		if (!item) {
+			continue;
+		}
+
+		itemTypeCounts[item->getID()] += Item::countByType(item, -1);
+
+		if (Container* container = item->getContainer()) {
+			for (ContainerIterator it = container->iterator(); it.hasNext(); it.advance()) {
+				itemTypeCounts[(*it)->getID()] += Item::countByType(*it, -1);
+			}
+		}
+	}
+
+	itemTypeCountsValid = true;
+	return itemTypeCounts;
+}
+
 bool Player::removeItemOfType(uint16_t itemId, uint32_t amount, int32_t subType, bool ignoreEquipped /* = false*/) const
 {
 	if (amount == 0) {
 		return true;
 	}
 
+	// the index only knows totals, so equipped items or a specific subtype still need the walk below
+	if (subType == -1 && !ignoreEquipped && getItemTypeCount(itemId) < amount) {
+		return false;
+	}
+
 	std::vector<Item*> itemList;
 
 	uint32_t count = 0;
@@ -2852,19 +2948,8 @@ bool Player::removeItemOfType(uint16_t itemId, uint32_t amount, int32_t subType,
 
 std::map<uint32_t, uint32_t>& Player::getAllItemTypeCount(std::map<uint32_t, uint32_t>& countMap) const
 {
-	for (int32_t i = CONST_SLOT_FIRST; i <= CONST_SLOT_LAST; i++) {
-		Item* item = inventory[i];
-		if (!item) {
-			continue;
-		}
-
-		countMap[item->getID()] += Item::countByType(item, -1);
-
-		if (Container* container = item->getContainer()) {
-			for (ContainerIterator it = container->iterator(); it.hasNext(); it.advance()) {
-				countMap[(*it)->getID()] += Item::countByType(*it, -1);
-			}
-		}
+	for (const auto& it : getItemTypeCounts()) {
+		countMap[it.first] += it.second;
 	}
 	return countMap;
 }
@@ -3055,6 +3140,7 @@ void Player::internalAddThing(uint32_t index, Thing* thing)
 
 		inventory[index] = item;
 		item->setParent(this);
+		invalidateItemTypeCounts();
 	}
 }
 
@@ -222,6 +222,7 @@ public:
 		}
 	}
 	uint32_t getIP() const;
+	Connection_ptr getConnection() const;
 	uint32_t getLastIP() const { return lastIP; }
 
 	void addContainer(uint8_t cid, Container* container);
@@ -320,6 +321,11 @@ public:
 
 	Item* getInventoryItem(slots_t slot) const;
 
+	// the carried item counts follow every add, update and remove on the player and the containers it holds
+	void addItemTypeCount(uint16_t itemId, int32_t delta);
+	void addItemTypeCounts(const Item* item, int32_t sign);
+	void invalidateItemTypeCounts() { itemTypeCountsValid = false; }
+
 	bool isItemAbilityEnabled(slots_t slot) const { return inventoryAbilities[slot]; }
 	void setItemAbility(slots_t slot, bool enabled) { inventoryAbilities[slot] = enabled; }
 
@@ -903,6 +909,13 @@ public:
 			client->writeToOutputBuffer(message);
 		}
 	}
+	// only sent when pos is inside the client's view
+	void sendNetworkMessage(const Position& pos, const NetworkMessage& message)
+	{
+		if (client) {
+			client->writeToOutputBuffer(pos, message);
+		}
+	}
 
 	void receivePing() { lastPong = OTSYS_TIME(); }
 
@@ -1016,6 +1029,8 @@ private:
 	size_t getFirstIndex() const override;
 	size_t getLastIndex() const override;
 	std::map<uint32_t, uint32_t>& getAllItemTypeCount(std::map<uint32_t, uint32_t>& countMap) const override;
+	const std::unordered_map<uint16_t, uint32_t>& getItemTypeCounts() const;
+	uint32_t countItemsOfType(uint16_t itemId, int32_t subType) const;
 
 	void internalAddThing(Thing* thing) override;
 	void internalAddThing(uint32_t index, Thing* thing) override;
@@ -1028,7 +1043,13 @@ private:
 	std::map<uint32_t, DepotChest*> depotChests;
 
 	std::unordered_map<uint16_t, uint8_t> outfits;
+	// carried item count per item id, built on the first query after login and adjusted by every change since
+	mutable std::unordered_map<uint16_t, uint32_t> itemTypeCounts;
 	std::unordered_set<uint16_t> mounts;
+	// storage keys changed since they were last written, with the value to write or nullopt to delete the row
+	std::unordered_map<uint32_t, std::optional<int64_t>> storageChanges;
+	// storage writes since the last flush, those beyond storageChanges.size() were coalesced
+	uint32_t storageUpdates = 0;
 	GuildWarVector guildWarVector;
 
 	std::list<ShopInfo> shopItemList;
@@ -1134,6 +1155,7 @@ private:
 	bool isConnecting = false;
 	bool addAttackSkillPoint = false;
 	bool randomizeMount = false;
+	mutable bool itemTypeCountsValid = false;
 	bool inventoryAbilities[CONST_SLOT_LAST + 1] = {};
 
 	void updateItemsLight(bool internal = false);
@@ -69,7 +69,10 @@ OutputMessage_ptr Protocol::getOutputBuffer(int32_t size)
 	// dispatcher thread
 	if (!outputBuffer) {
 		outputBuffer = OutputMessagePool::getOutputMessage();
-	} else if ((outputBuffer->getLength() + size) > NetworkMessage::MAX_PROTOCOL_BODY_LENGTH) {
+		if (autosend && !autosendPending) {
+			OutputMessagePool::getInstance().addPendingProtocol(shared_from_this());
+		}
+	} else if ((outputBuffer->getLength() + size) > OUTPUTMESSAGE_FLUSH_THRESHOLD) {
 		send(outputBuffer);
 		outputBuffer = OutputMessagePool::getOutputMessage();
 	}
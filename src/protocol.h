@@ -64,6 +64,7 @@ protected:
 
 private:
 	friend class Connection;
+	friend class OutputMessagePool;
 
 	OutputMessage_ptr outputBuffer;
 
@@ -72,6 +73,9 @@ private:
 	bool encryptionEnabled = false;
 	bool checksumEnabled = true;
 	bool rawMessages = false;
+	// registered for autosend / currently waiting in the pool's pending list
+	bool autosend = false;
+	bool autosendPending = false;
 };
 
 #endif
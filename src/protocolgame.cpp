@@ -8,6 +8,7 @@
 #include "actions.h"
 #include "ban.h"
 #include "configmanager.h"
+#include "databasetasks.h"
 #include "game.h"
 #include "iologindata.h"
 #include "outputmessage.h"
@@ -23,6 +24,23 @@ using WaitList = std::deque<std::pair<int64_t, uint32_t>>; // (timeout, player g
 
 WaitList priorityWaitList, waitList;
 
+// characters whose data is being fetched by the database worker, by guid, with their account
+std::unordered_multimap<uint32_t, uint32_t> loadingCharacters;
+// how often the rows of a loading character were changed offline, a login that fetched them before the last change
+// fetches them again
+std::unordered_map<uint32_t, uint32_t> loadingCharacterChanges;
+
+bool isAccountLoading(uint32_t accountId)
+{
+	return std::any_of(loadingCharacters.begin(), loadingCharacters.end(),
+	                   [accountId](const auto& it) { return it.second == accountId; });
+}
+
+int64_t getElapsedMicroseconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 std::tuple<WaitList&, WaitList::iterator, WaitList::size_type> findClient(const Player& player)
 {
 	const auto fn = [&](const WaitList::value_type& it) { return it.second == player.getGUID(); };
@@ -132,10 +150,17 @@ void ProtocolGame::release()
 void ProtocolGame::login(uint32_t characterId, uint32_t accountId, OperatingSystem_t operatingSystem)
 {
 	// dispatcher thread
+	const auto loginStart = std::chrono::steady_clock::now();
+
 	Player* foundPlayer = g_game.getPlayerByGUID(characterId);
 	const bool isAccountManager =
 	    getBoolean(ConfigManager::ACCOUNT_MANAGER) && characterId == ACCOUNT_MANAGER_PLAYER_ID;
 	if (!foundPlayer || getBoolean(ConfigManager::ALLOW_CLONES) || isAccountManager) {
+		if (!getBoolean(ConfigManager::ALLOW_CLONES) && !isAccountManager && loadingCharacters.count(characterId)) {
+			disconnectClient("You are already logged in.");
+			return;
+		}
+
 		player = new Player(getThis());
 		player->setGUID(characterId);
 
@@ -163,7 +188,8 @@ void ProtocolGame::login(uint32_t characterId, uint32_t accountId, OperatingSyst
 		}
 
 		if (getBoolean(ConfigManager::ONE_PLAYER_ON_ACCOUNT) && !isAccountManager &&
-		    player->getAccountType() < ACCOUNT_TYPE_GAMEMASTER && g_game.getPlayerByAccount(player->getAccount())) {
+		    player->getAccountType() < ACCOUNT_TYPE_GAMEMASTER &&
+		    (g_game.getPlayerByAccount(player->getAccount()) || isAccountLoading(player->getAccount()))) {
 			disconnectClient("You may only login with one character\nof your account at the same time.");
 			return;
 		}
@@ -200,31 +226,11 @@ void ProtocolGame::login(uint32_t characterId, uint32_t accountId, OperatingSyst
 			return;
 		}
 
-		if (!IOLoginData::loadPlayerById(player, player->getGUID())) {
-			disconnectClient("Your character could not be loaded.");
-			return;
-		}
-
-		player->setOperatingSystem(operatingSystem);
-
-		if (isAccountManager) {
-			player->accountNumber = accountId;
-		}
-
-		if (!g_game.placeCreature(player, player->getLoginPosition())) {
-			if (!g_game.placeCreature(player, player->getTemplePosition(), false, true)) {
-				disconnectClient("Temple position is wrong. Contact the administrator.");
-				return;
-			}
-		}
-
-		if (operatingSystem >= CLIENTOS_OTCLIENT_LINUX) {
-			player->registerCreatureEvent("ExtendedOpcode");
-		}
-
-		player->lastIP = player->getIP();
-		player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
-		acceptPackets = true;
+		// the rest of the character is read on the database worker, building and placing it happens back here
+		loadingCharacters.emplace(characterId, player->getAccount());
+		fetchCharacter(characterId, accountId, operatingSystem, isAccountManager,
+		               getElapsedMicroseconds(loginStart));
+		return;
 	} else {
 		if (eventConnect != 0 || !getBoolean(ConfigManager::REPLACE_KICK_ON_LOGIN)) {
 			// Already trying to connect
@@ -247,6 +253,95 @@ void ProtocolGame::login(uint32_t characterId, uint32_t accountId, OperatingSyst
 	OutputMessagePool::getInstance().addProtocolToAutosend(shared_from_this());
 }
 
+bool ProtocolGame::isCharacterLoading(uint32_t characterId) { return loadingCharacters.contains(characterId); }
+
+void ProtocolGame::onCharacterChanged(uint32_t characterId)
+{
+	if (loadingCharacters.contains(characterId)) {
+		++loadingCharacterChanges[characterId];
+	}
+}
+
+void ProtocolGame::fetchCharacter(uint32_t characterId, uint32_t accountId, OperatingSystem_t operatingSystem,
+                                  bool isAccountManager, int64_t loginTime)
+{
+	const uint32_t changes = loadingCharacterChanges[characterId];
+	g_databaseTasks.addJob([=, thisPtr = getThis()](Database& db) {
+		g_dispatcher.addTask([=, data = IOLoginData::fetchPlayerById(db, characterId)]() {
+			thisPtr->finishLogin(data, characterId, accountId, operatingSystem, isAccountManager, loginTime,
+			                     changes);
+		});
+	});
+}
+
+void ProtocolGame::finishLogin(const PlayerLoadData& data, uint32_t characterId, uint32_t accountId,
+                               OperatingSystem_t operatingSystem, bool isAccountManager, int64_t loginTime,
+                               uint32_t changes)
+{
+	// dispatcher thread
+	const auto finishStart = std::chrono::steady_clock::now();
+
+	// the rows were changed offline after they were read, building the character from them would undo that
+	if (player && loadingCharacterChanges[characterId] != changes) {
+		fetchCharacter(characterId, accountId, operatingSystem, isAccountManager,
+		               loginTime + getElapsedMicroseconds(finishStart));
+		return;
+	}
+
+	if (auto it = loadingCharacters.find(characterId); it != loadingCharacters.end()) {
+		loadingCharacters.erase(it);
+	}
+
+	if (!loadingCharacters.contains(characterId)) {
+		loadingCharacterChanges.erase(characterId);
+	}
+
+	if (!player) {
+		// the client went away while its character was being fetched
+		return;
+	}
+
+	if (!IOLoginData::loadPlayer(player, data)) {
+		disconnectClient("Your character could not be loaded.");
+		return;
+	}
+
+	player->setOperatingSystem(operatingSystem);
+
+	if (isAccountManager) {
+		player->accountNumber = accountId;
+	}
+
+	// the server may have started going down while the character was being fetched
+	if (g_game.getGameState() == GAME_STATE_CLOSING && !player->hasFlag(PlayerFlag_CanAlwaysLogin)) {
+		disconnectClient("The game is just going down.\nPlease try again later.");
+		return;
+	}
+
+	if (g_game.getGameState() == GAME_STATE_CLOSED && !player->hasFlag(PlayerFlag_CanAlwaysLogin)) {
+		disconnectClient("Server is currently closed.\nPlease try again later.");
+		return;
+	}
+
+	if (!g_game.placeCreature(player, player->getLoginPosition())) {
+		if (!g_game.placeCreature(player, player->getTemplePosition(), false, true)) {
+			disconnectClient("Temple position is wrong. Contact the administrator.");
+			return;
+		}
+	}
+
+	if (operatingSystem >= CLIENTOS_OTCLIENT_LINUX) {
+		player->registerCreatureEvent("ExtendedOpcode");
+	}
+
+	player->lastIP = player->getIP();
+	player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
+	acceptPackets = true;
+	OutputMessagePool::getInstance().addProtocolToAutosend(shared_from_this());
+
+	g_game.addLoginTime(loginTime + getElapsedMicroseconds(finishStart));
+}
+
 void ProtocolGame::connect(uint32_t playerId, OperatingSystem_t operatingSystem)
 {
 	eventConnect = 0;
@@ -1764,30 +1859,7 @@ void ProtocolGame::sendCreatureSay(const Creature* creature, SpeakClasses type,
 	}
 
 	NetworkMessage msg;
-	msg.addByte(0xAA);
-	msg.add<uint32_t>(0x00);
-
-	msg.addString(creature->getName());
-
-	// Add level only for players
-	if (const Player* speaker = creature->getPlayer()) {
-		if (!speaker->isAccessPlayer() && !speaker->isAccountManager()) {
-			msg.add<uint16_t>(static_cast<uint16_t>(speaker->getLevel()));
-		} else {
-			msg.add<uint16_t>(0x00);
-		}
-	} else {
-		msg.add<uint16_t>(0x00);
-	}
-
-	msg.addByte(type);
-	if (pos) {
-		msg.addPosition(*pos);
-	} else {
-		msg.addPosition(creature->getPosition());
-	}
-
-	msg.addString(text);
+	AddCreatureSay(msg, creature, type, text, pos);
 	writeToOutputBuffer(msg);
 }
 
@@ -1887,10 +1959,7 @@ void ProtocolGame::sendPing()
 void ProtocolGame::sendDistanceShoot(const Position& from, const Position& to, uint8_t type)
 {
 	NetworkMessage msg;
-	msg.addByte(0x85);
-	msg.addPosition(from);
-	msg.addPosition(to);
-	msg.addByte(type);
+	AddDistanceShoot(msg, from, to, type);
 	writeToOutputBuffer(msg);
 }
 
@@ -1901,24 +1970,14 @@ void ProtocolGame::sendMagicEffect(const Position& pos, uint8_t type)
 	}
 
 	NetworkMessage msg;
-	msg.addByte(0x83);
-	msg.addPosition(pos);
-	msg.addByte(type);
+	AddMagicEffect(msg, pos, type);
 	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCreatureHealth(const Creature* creature)
 {
 	NetworkMessage msg;
-	msg.addByte(0x8C);
-	msg.add<uint32_t>(creature->getID());
-
-	if (creature->isHealthHidden()) {
-		msg.addByte(0x00);
-	} else {
-		msg.addByte(std::ceil(
-		    (static_cast<double>(creature->getHealth()) / std::max<int32_t>(creature->getMaxHealth(), 1)) * 100));
-	}
+	AddCreatureHealth(msg, creature);
 	writeToOutputBuffer(msg);
 }
 
@@ -2400,14 +2459,77 @@ void ProtocolGame::sendAnimatedText(std::string_view message, const Position& po
 	}
 
 	NetworkMessage msg;
+	AddAnimatedText(msg, message, pos, color);
+	writeToOutputBuffer(msg);
+}
+
+////////////// Add common messages
+void ProtocolGame::AddMagicEffect(NetworkMessage& msg, const Position& pos, uint8_t type)
+{
+	msg.addByte(0x83);
+	msg.addPosition(pos);
+	msg.addByte(type);
+}
+
+void ProtocolGame::AddDistanceShoot(NetworkMessage& msg, const Position& from, const Position& to, uint8_t type)
+{
+	msg.addByte(0x85);
+	msg.addPosition(from);
+	msg.addPosition(to);
+	msg.addByte(type);
+}
+
+void ProtocolGame::AddCreatureHealth(NetworkMessage& msg, const Creature* creature)
+{
+	msg.addByte(0x8C);
+	msg.add<uint32_t>(creature->getID());
+
+	if (creature->isHealthHidden()) {
+		msg.addByte(0x00);
+	} else {
+		msg.addByte(std::ceil(
+		    (static_cast<double>(creature->getHealth()) / std::max<int32_t>(creature->getMaxHealth(), 1)) * 100));
+	}
+}
+
+void ProtocolGame::AddAnimatedText(NetworkMessage& msg, std::string_view message, const Position& pos,
+                                   TextColor_t color)
+{
 	msg.addByte(0x84);
 	msg.addPosition(pos);
 	msg.addByte(color);
 	msg.addString(message);
-	writeToOutputBuffer(msg);
 }
 
-////////////// Add common messages
+void ProtocolGame::AddCreatureSay(NetworkMessage& msg, const Creature* creature, SpeakClasses type,
+                                  std::string_view text, const Position* pos)
+{
+	msg.addByte(0xAA);
+	msg.add<uint32_t>(0x00);
+
+	msg.addString(creature->getName());
+
+	// Add level only for players
+	if (const Player* speaker = creature->getPlayer()) {
+		if (!speaker->isAccessPlayer() && !speaker->isAccountManager()) {
+			msg.add<uint16_t>(static_cast<uint16_t>(speaker->getLevel()));
+		} else {
+			msg.add<uint16_t>(0x00);
+		}
+	} else {
+		msg.add<uint16_t>(0x00);
+	}
+
+	msg.addByte(type);
+	if (pos) {
+		msg.addPosition(*pos);
+	} else {
+		msg.addPosition(creature->getPosition());
+	}
+
+	msg.addString(text);
+}
+
 void ProtocolGame::AddCreature(NetworkMessage& msg, const Creature* creature, bool known, uint32_t remove)
 {
 	const Player* otherPlayer = creature->getPlayer();
@@ -17,6 +17,7 @@ class Container;
 class Tile;
 class Connection;
 class ProtocolGame;
+struct PlayerLoadData;
 using ProtocolGame_ptr = std::shared_ptr<ProtocolGame>;
 
 extern Game g_game;
@@ -65,11 +66,35 @@ public:
 
 	uint16_t getVersion() const { return version; }
 
+	// characters whose rows are being fetched for a login are neither online nor safe to change offline; a change
+	// written to their rows meanwhile has to be reported so that the login reads them again
+	static bool isCharacterLoading(uint32_t characterId);
+	static void onCharacterChanged(uint32_t characterId);
+
+	// viewer independent packets, encoded once by Game and appended to every spectator's buffer
+	static void AddMagicEffect(NetworkMessage& msg, const Position& pos, uint8_t type);
+	static void AddDistanceShoot(NetworkMessage& msg, const Position& from, const Position& to, uint8_t type);
+	static void AddCreatureHealth(NetworkMessage& msg, const Creature* creature);
+	static void AddAnimatedText(NetworkMessage& msg, std::string_view message, const Position& pos,
+	                            TextColor_t color);
+	static void AddCreatureSay(NetworkMessage& msg, const Creature* creature, SpeakClasses type,
+	                           std::string_view text, const Position* pos);
+
 private:
 	ProtocolGame_ptr getThis() { return std::static_pointer_cast<ProtocolGame>(shared_from_this()); }
 	void connect(uint32_t playerId, OperatingSystem_t operatingSystem);
+	void fetchCharacter(uint32_t characterId, uint32_t accountId, OperatingSystem_t operatingSystem,
+	                    bool isAccountManager, int64_t loginTime);
+	void finishLogin(const PlayerLoadData& data, uint32_t characterId, uint32_t accountId,
+	                 OperatingSystem_t operatingSystem, bool isAccountManager, int64_t loginTime, uint32_t changes);
 	void disconnectClient(std::string_view message) const;
 	void writeToOutputBuffer(const NetworkMessage& msg);
+	void writeToOutputBuffer(const Position& pos, const NetworkMessage& msg)
+	{
+		if (canSee(pos)) {
+			writeToOutputBuffer(msg);
+		}
+	}
 
 	void release() override;
 
@@ -9,9 +9,16 @@
 #include "game.h"
 #include "outputmessage.h"
 
+#include <bit>
+
 extern Game g_game;
 
 std::map<uint32_t, int64_t> ProtocolStatus::ipConnectMap;
+std::mutex ProtocolStatus::ipConnectMapLock;
+std::shared_ptr<const StatusSnapshot> ProtocolStatus::statusSnapshot;
+std::mutex ProtocolStatus::statusSnapshotLock;
+std::atomic_bool ProtocolStatus::statusSnapshotOutdated{false};
+std::atomic_bool ProtocolStatus::statusSnapshotRendering{false};
 const uint64_t ProtocolStatus::start = OTSYS_TIME();
 
 enum RequestedInfo_t : uint16_t
@@ -26,60 +33,43 @@ enum RequestedInfo_t : uint16_t
 	REQUEST_SERVER_SOFTWARE_INFO = 1 << 7,
 };
 
-void ProtocolStatus::onRecvFirstMessage(NetworkMessage& msg)
-{
-	uint32_t ip = getIP();
-	if (ip != 0x0100007F) {
-		std::string ipStr = convertIPToString(ip);
-		if (ipStr != getString(ConfigManager::IP)) {
-			std::map<uint32_t, int64_t>::const_iterator it = ipConnectMap.find(ip);
-			if (it != ipConnectMap.end() &&
-			    (OTSYS_TIME() < (it->second + getInteger(ConfigManager::STATUSQUERY_TIMEOUT)))) {
-				disconnect();
-				return;
-			}
-		}
-	}
-
-	ipConnectMap[ip] = OTSYS_TIME();
+namespace {
 
-	switch (msg.getByte()) {
-		// XML info protocol
-		case 0xFF: {
-			if (msg.getString(4) == "info") {
-				g_dispatcher.addTask([thisPtr = std::static_pointer_cast<ProtocolStatus>(shared_from_this())]() {
-					thisPtr->sendStatusString();
-				});
-				return;
-			}
-			break;
-		}
+void appendByte(std::string& block, uint8_t value) { block.push_back(static_cast<char>(value)); }
 
-		// Another ServerInfo protocol
-		case 0x01: {
-			uint16_t requestedInfo = msg.get<uint16_t>(); // only a Byte is necessary, though we could add new info here
-			std::string_view characterName;
-			if (requestedInfo & REQUEST_PLAYER_STATUS_INFO) {
-				characterName = msg.getString();
-			}
-			g_dispatcher.addTask(
-			    [=, thisPtr = std::static_pointer_cast<ProtocolStatus>(shared_from_this()),
-			     characterName = std::string{characterName}]() { thisPtr->sendInfo(requestedInfo, characterName); });
-			return;
-		}
+template <typename T>
+void appendValue(std::string& block, T value)
+{
+	block.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
 
-		default:
-			break;
+// same encoding as NetworkMessage::addString
+void appendString(std::string& block, std::string_view value)
+{
+	if (value.length() > 8192) {
+		return;
 	}
-	disconnect();
+
+	appendValue<uint16_t>(block, value.length());
+	block.append(value);
 }
 
-void ProtocolStatus::sendStatusString()
+// NetworkMessage::addBytes takes at most 8192 bytes at a time
+void addBlock(NetworkMessage& msg, std::string_view block)
 {
-	auto output = OutputMessagePool::getOutputMessage();
+	while (!block.empty()) {
+		const size_t size = std::min<size_t>(block.size(), 8192);
+		msg.addBytes(block.data(), size);
+		block.remove_prefix(size);
+	}
+}
 
-	setRawMessages(true);
+constexpr size_t getInfoBlockIndex(RequestedInfo_t info) { return std::countr_zero(static_cast<uint16_t>(info)); }
 
+} // namespace
+
+StatusSnapshot::StatusSnapshot(const StatusInfo& info, int64_t renderedAt) : renderedAt(renderedAt)
+{
 	pugi::xml_document doc;
 
 	pugi::xml_node decl = doc.prepend_child(pugi::node_declaration);
@@ -89,8 +79,7 @@ void ProtocolStatus::sendStatusString()
 	tsqp.append_attribute("version") = "1.0";
 
 	pugi::xml_node serverinfo = tsqp.append_child("serverinfo");
-	uint64_t uptime = (OTSYS_TIME() - ProtocolStatus::start) / 1000;
-	serverinfo.append_attribute("uptime") = std::to_string(uptime).c_str();
+	serverinfo.append_attribute("uptime") = std::to_string(info.uptime).c_str();
 	serverinfo.append_attribute("ip") = getString(ConfigManager::IP).data();
 	serverinfo.append_attribute("servername") = getString(ConfigManager::SERVER_NAME).data();
 	serverinfo.append_attribute("port") = std::to_string(getInteger(ConfigManager::LOGIN_PORT)).c_str();
@@ -105,15 +94,15 @@ void ProtocolStatus::sendStatusString()
 	owner.append_attribute("email") = getString(ConfigManager::OWNER_EMAIL).data();
 
 	pugi::xml_node players = tsqp.append_child("players");
-	players.append_attribute("online") = std::to_string(g_game.getPlayersOnline()).c_str();
+	players.append_attribute("online") = std::to_string(info.playersOnline).c_str();
 	players.append_attribute("max") = std::to_string(getInteger(ConfigManager::MAX_PLAYERS)).c_str();
-	players.append_attribute("peak") = std::to_string(g_game.getPlayersRecord()).c_str();
+	players.append_attribute("peak") = std::to_string(info.playersRecord).c_str();
 
 	pugi::xml_node monsters = tsqp.append_child("monsters");
-	monsters.append_attribute("total") = std::to_string(g_game.getMonstersOnline()).c_str();
+	monsters.append_attribute("total") = std::to_string(info.monstersOnline).c_str();
 
 	pugi::xml_node npcs = tsqp.append_child("npcs");
-	npcs.append_attribute("total") = std::to_string(g_game.getNpcsOnline()).c_str();
+	npcs.append_attribute("total") = std::to_string(info.npcsOnline).c_str();
 
 	pugi::xml_node rates = tsqp.append_child("rates");
 	rates.append_attribute("experience") = std::to_string(getInteger(ConfigManager::RATE_EXPERIENCE)).c_str();
@@ -125,92 +114,210 @@ void ProtocolStatus::sendStatusString()
 	pugi::xml_node map = tsqp.append_child("map");
 	map.append_attribute("name") = getString(ConfigManager::MAP_NAME).data();
 	map.append_attribute("author") = getString(ConfigManager::MAP_AUTHOR).data();
-
-	uint32_t mapWidth, mapHeight;
-	g_game.getMapDimensions(mapWidth, mapHeight);
-	map.append_attribute("width") = std::to_string(mapWidth).c_str();
-	map.append_attribute("height") = std::to_string(mapHeight).c_str();
+	map.append_attribute("width") = std::to_string(info.mapWidth).c_str();
+	map.append_attribute("height") = std::to_string(info.mapHeight).c_str();
 
 	pugi::xml_node motd = tsqp.append_child("motd");
 	motd.text() = getString(ConfigManager::MOTD).data();
 
 	std::ostringstream ss;
 	doc.save(ss, "", pugi::format_raw);
+	statusString = ss.str();
+
+	std::string& basic = infoBlocks[getInfoBlockIndex(REQUEST_BASIC_SERVER_INFO)];
+	appendByte(basic, 0x10);
+	appendString(basic, getString(ConfigManager::SERVER_NAME));
+	appendString(basic, getString(ConfigManager::IP));
+	appendString(basic, std::to_string(getInteger(ConfigManager::LOGIN_PORT)));
+
+	std::string& ownerInfo = infoBlocks[getInfoBlockIndex(REQUEST_OWNER_SERVER_INFO)];
+	appendByte(ownerInfo, 0x11);
+	appendString(ownerInfo, getString(ConfigManager::OWNER_NAME));
+	appendString(ownerInfo, getString(ConfigManager::OWNER_EMAIL));
+
+	std::string& misc = infoBlocks[getInfoBlockIndex(REQUEST_MISC_SERVER_INFO)];
+	appendByte(misc, 0x12);
+	appendString(misc, getString(ConfigManager::MOTD));
+	appendString(misc, getString(ConfigManager::LOCATION));
+	appendString(misc, getString(ConfigManager::URL));
+	appendValue<uint64_t>(misc, info.uptime);
+
+	std::string& playersInfo = infoBlocks[getInfoBlockIndex(REQUEST_PLAYERS_INFO)];
+	appendByte(playersInfo, 0x20);
+	appendValue<uint32_t>(playersInfo, info.playersOnline);
+	appendValue<uint32_t>(playersInfo, getInteger(ConfigManager::MAX_PLAYERS));
+	appendValue<uint32_t>(playersInfo, info.playersRecord);
+
+	std::string& mapInfo = infoBlocks[getInfoBlockIndex(REQUEST_MAP_INFO)];
+	appendByte(mapInfo, 0x30);
+	appendString(mapInfo, getString(ConfigManager::MAP_NAME));
+	appendString(mapInfo, getString(ConfigManager::MAP_AUTHOR));
+	appendValue<uint16_t>(mapInfo, static_cast<uint16_t>(info.mapWidth));
+	appendValue<uint16_t>(mapInfo, static_cast<uint16_t>(info.mapHeight));
+
+	std::string& playerList = infoBlocks[getInfoBlockIndex(REQUEST_EXT_PLAYERS_INFO)];
+	appendByte(playerList, 0x21); // players info - online players list
+	appendValue<uint32_t>(playerList, info.players.size());
+	onlineNames.reserve(info.players.size());
+	for (const auto& [name, level] : info.players) {
+		appendString(playerList, name);
+		appendValue<uint32_t>(playerList, level);
+		onlineNames.insert(boost::algorithm::to_lower_copy(name));
+	}
 
-	std::string data = ss.str();
-	output->addBytes(data.c_str(), data.size());
-	send(output);
-	disconnect();
+	std::string& software = infoBlocks[getInfoBlockIndex(REQUEST_SERVER_SOFTWARE_INFO)];
+	appendByte(software, 0x23); // server software info
+	appendString(software, STATUS_SERVER_NAME);
+	appendString(software, STATUS_SERVER_VERSION);
+	appendString(software, CLIENT_VERSION_STR);
 }
 
-void ProtocolStatus::sendInfo(uint16_t requestedInfo, std::string_view characterName)
+void StatusSnapshot::writeInfo(NetworkMessage& msg, uint16_t requestedInfo, std::string_view characterName) const
 {
-	auto output = OutputMessagePool::getOutputMessage();
+	for (size_t i = 0; i < infoBlocks.size(); ++i) {
+		if (!(requestedInfo & (1 << i))) {
+			continue;
+		}
 
-	if (requestedInfo & REQUEST_BASIC_SERVER_INFO) {
-		output->addByte(0x10);
-		output->addString(getString(ConfigManager::SERVER_NAME));
-		output->addString(getString(ConfigManager::IP));
-		output->addString(std::to_string(getInteger(ConfigManager::LOGIN_PORT)));
-	}
+		if (i == getInfoBlockIndex(REQUEST_PLAYER_STATUS_INFO)) {
+			msg.addByte(0x22); // players info - online status info of a player
+			if (onlineNames.find(boost::algorithm::to_lower_copy(std::string{characterName})) != onlineNames.end()) {
+				msg.addByte(0x01);
+			} else {
+				msg.addByte(0x00);
+			}
+			continue;
+		}
 
-	if (requestedInfo & REQUEST_OWNER_SERVER_INFO) {
-		output->addByte(0x11);
-		output->addString(getString(ConfigManager::OWNER_NAME));
-		output->addString(getString(ConfigManager::OWNER_EMAIL));
+		addBlock(msg, infoBlocks[i]);
 	}
+}
 
-	if (requestedInfo & REQUEST_MISC_SERVER_INFO) {
-		output->addByte(0x12);
-		output->addString(getString(ConfigManager::MOTD));
-		output->addString(getString(ConfigManager::LOCATION));
-		output->addString(getString(ConfigManager::URL));
-		output->add<uint64_t>((OTSYS_TIME() - ProtocolStatus::start) / 1000);
+std::shared_ptr<const StatusSnapshot> ProtocolStatus::getStatusSnapshot()
+{
+	std::shared_ptr<const StatusSnapshot> snapshot;
+	{
+		std::lock_guard<std::mutex> lockClass(statusSnapshotLock);
+		snapshot = statusSnapshot;
 	}
 
-	if (requestedInfo & REQUEST_PLAYERS_INFO) {
-		output->addByte(0x20);
-		output->add<uint32_t>(g_game.getPlayersOnline());
-		output->add<uint32_t>(getInteger(ConfigManager::MAX_PLAYERS));
-		output->add<uint32_t>(g_game.getPlayersRecord());
+	if (!snapshot || statusSnapshotOutdated ||
+	    OTSYS_TIME() >= snapshot->getRenderedAt() + getInteger(ConfigManager::STATUS_CACHE_INTERVAL)) {
+		// one render at a time, requests keep getting the previous snapshot meanwhile
+		if (!statusSnapshotRendering.exchange(true)) {
+			g_dispatcher.addTask([]() { renderStatusSnapshot(); });
+		}
 	}
+	return snapshot;
+}
 
-	if (requestedInfo & REQUEST_MAP_INFO) {
-		output->addByte(0x30);
-		output->addString(getString(ConfigManager::MAP_NAME));
-		output->addString(getString(ConfigManager::MAP_AUTHOR));
-		uint32_t mapWidth, mapHeight;
-		g_game.getMapDimensions(mapWidth, mapHeight);
-		output->add<uint16_t>(static_cast<uint16_t>(mapWidth));
-		output->add<uint16_t>(static_cast<uint16_t>(mapHeight));
+std::shared_ptr<const StatusSnapshot> ProtocolStatus::renderStatusSnapshot()
+{
+	statusSnapshotOutdated = false;
+
+	StatusInfo info;
+	info.uptime = (OTSYS_TIME() - ProtocolStatus::start) / 1000;
+	info.playersOnline = g_game.getPlayersOnline();
+	info.playersRecord = g_game.getPlayersRecord();
+	info.monstersOnline = g_game.getMonstersOnline();
+	info.npcsOnline = g_game.getNpcsOnline();
+	g_game.getMapDimensions(info.mapWidth, info.mapHeight);
+
+	const auto& players = g_game.getPlayers();
+	info.players.reserve(players.size());
+	for (const auto& it : players) {
+		info.players.emplace_back(it.second->getName(), it.second->getLevel());
 	}
 
-	if (requestedInfo & REQUEST_EXT_PLAYERS_INFO) {
-		output->addByte(0x21); // players info - online players list
+	auto snapshot = std::make_shared<const StatusSnapshot>(info, OTSYS_TIME());
+	{
+		std::lock_guard<std::mutex> lockClass(statusSnapshotLock);
+		statusSnapshot = snapshot;
+	}
+	statusSnapshotRendering = false;
+	return snapshot;
+}
 
-		const auto& players = g_game.getPlayers();
-		output->add<uint32_t>(players.size());
-		for (const auto& it : players) {
-			output->addString(it.second->getName());
-			output->add<uint32_t>(it.second->getLevel());
+void ProtocolStatus::onRecvFirstMessage(NetworkMessage& msg)
+{
+	uint32_t ip = getIP();
+	{
+		// network threads may serve several status requests at once
+		std::lock_guard<std::mutex> lockClass(ipConnectMapLock);
+		if (ip != 0x0100007F) {
+			std::string ipStr = convertIPToString(ip);
+			if (ipStr != getString(ConfigManager::IP)) {
+				std::map<uint32_t, int64_t>::const_iterator it = ipConnectMap.find(ip);
+				if (it != ipConnectMap.end() &&
+				    (OTSYS_TIME() < (it->second + getInteger(ConfigManager::STATUSQUERY_TIMEOUT)))) {
+					disconnect();
+					return;
+				}
+			}
 		}
+
+		ipConnectMap[ip] = OTSYS_TIME();
 	}
 
-	if (requestedInfo & REQUEST_PLAYER_STATUS_INFO) {
-		output->addByte(0x22); // players info - online status info of a player
-		if (g_game.getPlayerByName(characterName) != nullptr) {
-			output->addByte(0x01);
-		} else {
-			output->addByte(0x00);
+	switch (msg.getByte()) {
+		// XML info protocol
+		case 0xFF: {
+			if (msg.getString(4) == "info") {
+				if (auto snapshot = getStatusSnapshot()) {
+					sendStatusString(*snapshot);
+					return;
+				}
+
+				// nothing rendered yet, answer from the dispatcher
+				g_dispatcher.addTask([thisPtr = std::static_pointer_cast<ProtocolStatus>(shared_from_this())]() {
+					thisPtr->sendStatusString(*renderStatusSnapshot());
+				});
+				return;
+			}
+			break;
 		}
-	}
 
-	if (requestedInfo & REQUEST_SERVER_SOFTWARE_INFO) {
-		output->addByte(0x23); // server software info
-		output->addString(STATUS_SERVER_NAME);
-		output->addString(STATUS_SERVER_VERSION);
-		output->addString(CLIENT_VERSION_STR);
+		// Another ServerInfo protocol
+		case 0x01: {
+			uint16_t requestedInfo = msg.get<uint16_t>(); // only a Byte is necessary, though we could add new info here
+			std::string_view characterName;
+			if (requestedInfo & REQUEST_PLAYER_STATUS_INFO) {
+				characterName = msg.getString();
+			}
+			if (auto snapshot = getStatusSnapshot()) {
+				sendInfo(*snapshot, requestedInfo, characterName);
+				return;
+			}
+
+			g_dispatcher.addTask([=, thisPtr = std::static_pointer_cast<ProtocolStatus>(shared_from_this()),
+			                      characterName = std::string{characterName}]() {
+				thisPtr->sendInfo(*renderStatusSnapshot(), requestedInfo, characterName);
+			});
+			return;
+		}
+
+		default:
+			break;
 	}
+	disconnect();
+}
+
+void ProtocolStatus::sendStatusString(const StatusSnapshot& snapshot)
+{
+	auto output = OutputMessagePool::getOutputMessage();
+
+	setRawMessages(true);
+
+	addBlock(*output, snapshot.getStatusString());
+	send(output);
+	disconnect();
+}
+
+void ProtocolStatus::sendInfo(const StatusSnapshot& snapshot, uint16_t requestedInfo, std::string_view characterName)
+{
+	auto output = OutputMessagePool::getOutputMessage();
+
+	snapshot.writeInfo(*output, requestedInfo, characterName);
 	send(output);
 	disconnect();
 }
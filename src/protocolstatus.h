@@ -7,6 +7,38 @@
 #include "networkmessage.h"
 #include "protocol.h"
 
+// Everything a status response is rendered from, gathered on the dispatcher.
+struct StatusInfo
+{
+	uint64_t uptime = 0;
+	uint32_t playersOnline = 0;
+	uint32_t playersRecord = 0;
+	uint32_t monstersOnline = 0;
+	uint32_t npcsOnline = 0;
+	uint32_t mapWidth = 0;
+	uint32_t mapHeight = 0;
+	std::vector<std::pair<std::string, uint32_t>> players; // name, level
+};
+
+// Status responses rendered once and shared, read-only, by every network thread answering a status request.
+class StatusSnapshot
+{
+public:
+	StatusSnapshot(const StatusInfo& info, int64_t renderedAt);
+
+	int64_t getRenderedAt() const { return renderedAt; }
+
+	std::string_view getStatusString() const { return statusString; }
+	void writeInfo(NetworkMessage& msg, uint16_t requestedInfo, std::string_view characterName) const;
+
+private:
+	int64_t renderedAt;
+	std::string statusString;
+	// binary info blocks indexed by the bit of their RequestedInfo_t flag, the player status block is built per request
+	std::array<std::string, 8> infoBlocks;
+	std::unordered_set<std::string> onlineNames; // lowercase
+};
+
 class ProtocolStatus final : public Protocol
 {
 public:
@@ -29,13 +61,26 @@ public:
 
 	void onRecvFirstMessage(NetworkMessage& msg) override;
 
-	void sendStatusString();
-	void sendInfo(uint16_t requestedInfo, std::string_view characterName);
+	void sendStatusString(const StatusSnapshot& snapshot);
+	void sendInfo(const StatusSnapshot& snapshot, uint16_t requestedInfo, std::string_view characterName);
+
+	// the current snapshot, asks the dispatcher for a fresh one when it is older than statusCacheInterval or the
+	// player list changed; empty until the first one is rendered
+	static std::shared_ptr<const StatusSnapshot> getStatusSnapshot();
+	// dispatcher thread
+	static std::shared_ptr<const StatusSnapshot> renderStatusSnapshot();
+	static void invalidateStatusSnapshot() { statusSnapshotOutdated = true; }
 
 	static const uint64_t start;
 
 private:
+	static std::shared_ptr<const StatusSnapshot> statusSnapshot;
+	static std::mutex statusSnapshotLock;
+	static std::atomic_bool statusSnapshotOutdated;
+	static std::atomic_bool statusSnapshotRendering;
+
 	static std::map<uint32_t, int64_t> ipConnectMap;
+	static std::mutex ipConnectMapLock;
 };
 
 #endif
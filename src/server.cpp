@@ -20,7 +20,21 @@ void ServiceManager::run()
 {
 	assert(!running);
 	running = true;
+
+	// the calling thread is the first network thread, connections are serialised by their own strands
+	const auto threadCount = std::max<int64_t>(1, getInteger(ConfigManager::NETWORK_THREADS));
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	for (int64_t i = 1; i < threadCount; ++i) {
+		threads.emplace_back([this]() { io_service.run(); });
+	}
+
 	io_service.run();
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
 }
 
 void ServiceManager::stop()
@@ -33,7 +47,7 @@ void ServiceManager::stop()
 
 	for (auto& servicePortIt : acceptors) {
 		try {
-			io_service.post([servicePort = servicePortIt.second]() { servicePort->onStopServer(); });
+			servicePortIt.second->onStopServer();
 		} catch (boost::system::system_error& e) {
 			std::cout << "[ServiceManager::stop] Network Error: " << e.what() << std::endl;
 		}
@@ -71,10 +85,11 @@ void ServicePort::accept()
 	}
 
 	auto connection = ConnectionManager::getInstance().createConnection(io_service, shared_from_this());
-	acceptor->async_accept(connection->getSocket(),
-	                       [=, thisPtr = shared_from_this()](const boost::system::error_code& error) {
-		                       thisPtr->onAccept(connection, error);
-	                       });
+	acceptor->async_accept(connection->getSocket(), boost::asio::bind_executor(
+	                                                    strand, [=, thisPtr = shared_from_this()](
+	                                                                const boost::system::error_code& error) {
+		                                                    thisPtr->onAccept(connection, error);
+	                                                    }));
 }
 
 void ServicePort::onAccept(Connection_ptr connection, const boost::system::error_code& error)
@@ -84,6 +99,8 @@ void ServicePort::onAccept(Connection_ptr connection, const boost::system::error
 			return;
 		}
 
+		connection->updateRemoteIp();
+
 		const auto remote_ip = connection->getIP();
 		if (remote_ip != 0 && g_bans.acceptConnection(remote_ip)) {
 			Service_ptr service = services.front();
@@ -124,12 +141,15 @@ Protocol_ptr ServicePort::make_protocol(bool checksummed, NetworkMessage& msg, c
 	return nullptr;
 }
 
-void ServicePort::onStopServer() { close(); }
+void ServicePort::onStopServer()
+{
+	boost::asio::post(strand, [thisPtr = shared_from_this()]() { thisPtr->close(); });
+}
 
 void ServicePort::openAcceptor(std::weak_ptr<ServicePort> weak_service, uint16_t port)
 {
 	if (auto service = weak_service.lock()) {
-		service->open(port);
+		boost::asio::post(service->strand, [service, port]() { service->open(port); });
 	}
 }
 
@@ -39,7 +39,7 @@ public:
 class ServicePort : public std::enable_shared_from_this<ServicePort>
 {
 public:
-	explicit ServicePort(boost::asio::io_service& io_service) : io_service(io_service) {}
+	explicit ServicePort(boost::asio::io_service& io_service) : io_service(io_service), strand(io_service) {}
 	~ServicePort();
 
 	// non-copyable
@@ -62,6 +62,7 @@ private:
 	void accept();
 
 	boost::asio::io_service& io_service;
+	boost::asio::io_service::strand strand;
 	std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
 	std::vector<Service_ptr> services;
 
@@ -209,18 +209,22 @@ void Spawns::startup()
 	}
 	npcList.clear();
 
+	const int64_t start = OTSYS_TIME();
+	uint32_t spawned = 0, failed = 0;
 	for (Spawn& spawn : spawnList) {
-		spawn.startup();
+		spawn.startup(spawned, failed);
 	}
+	std::cout << "> Spawned " << spawned << " monsters (" << failed << " failed) in "
+	          << (OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
 
 	started = true;
 }
 
 void Spawns::clear()
 {
-	for (Spawn& spawn : spawnList) {
-		spawn.stopEvent();
-	}
+	g_scheduler.stopEvent(checkEvent);
+	checkEvent = 0;
+	checkQueue = {};
 	spawnList.clear();
 
 	loaded = false;
@@ -238,10 +242,57 @@ bool Spawns::isInZone(const Position& centerPos, int32_t radius, const Position&
 	        (pos.getY() >= centerPos.getY() - radius) && (pos.getY() <= centerPos.getY() + radius));
 }
 
+void Spawns::scheduleCheck(Spawn& spawn, uint32_t spawnId, int64_t dueTime)
+{
+	checkQueue.push({dueTime, &spawn, spawnId});
+	if (checking || (checkEvent != 0 && checkEventTime <= dueTime)) {
+		return;
+	}
+
+	g_scheduler.stopEvent(checkEvent);
+	checkEventTime = dueTime;
+	checkEvent = g_scheduler.addEvent(createSchedulerTask(
+	    std::max<int64_t>(SCHEDULER_MINTICKS, dueTime - OTSYS_TIME()), [this]() { checkSpawns(); }));
+}
+
+void Spawns::checkSpawns()
+{
+	checkEvent = 0;
+	checking = true;
+
+	const auto start = std::chrono::steady_clock::now();
+	const int64_t now = OTSYS_TIME();
+
+	std::unordered_map<const Spawn*, uint32_t> spawnCounts;
+	while (!checkQueue.empty() && checkQueue.top().dueTime <= now) {
+		SpawnCheck check = checkQueue.top();
+		checkQueue.pop();
+
+		++statistics.checks;
+		if (check.spawnId == 0) {
+			check.spawn->checkSpawn();
+		} else {
+			check.spawn->checkBlock(check.spawnId, spawnCounts[check.spawn], statistics);
+		}
+	}
+
+	statistics.checkTime +=
+	    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	checking = false;
+
+	if (!checkQueue.empty()) {
+		const int64_t dueTime = checkQueue.top().dueTime;
+		checkEventTime = dueTime;
+		checkEvent = g_scheduler.addEvent(createSchedulerTask(
+		    std::max<int64_t>(SCHEDULER_MINTICKS, dueTime - OTSYS_TIME()), [this]() { checkSpawns(); }));
+	}
+}
+
 void Spawn::startSpawnCheck()
 {
-	if (checkSpawnEvent == 0) {
-		checkSpawnEvent = g_scheduler.addEvent(createSchedulerTask(getInterval(), [this]() { checkSpawn(); }));
+	if (!checkQueued) {
+		checkQueued = true;
+		g_game.map.spawns.scheduleCheck(*this, 0, OTSYS_TIME() + getInterval());
 	}
 }
 
@@ -256,15 +307,10 @@ Spawn::~Spawn()
 
 bool Spawn::findPlayer(const Position& pos)
 {
-	SpectatorVec spectators;
-	g_game.map.getSpectators(spectators, pos, false, true);
-	for (Creature* spectator : spectators) {
-		assert(dynamic_cast<Player*>(spectator) != nullptr);
-		if (!static_cast<Player*>(spectator)->hasFlag(PlayerFlag_IgnoredByMonsters)) {
-			return true;
-		}
-	}
-	return false;
+	return g_game.map.hasPlayerSpectator(pos, [](const Creature* spectator) {
+		assert(dynamic_cast<const Player*>(spectator) != nullptr);
+		return !static_cast<const Player*>(spectator)->hasFlag(PlayerFlag_IgnoredByMonsters);
+	});
 }
 
 bool Spawn::isInSpawnZone(const Position& pos) { return Spawns::isInZone(centerPos, radius, pos); }
@@ -340,45 +386,70 @@ bool Spawn::spawnMonster(uint32_t spawnId, MonsterType* mType, const Position& p
 	return true;
 }
 
-void Spawn::startup()
+void Spawn::startup(uint32_t& spawned, uint32_t& failed)
 {
 	for (const auto& it : spawnMap) {
 		uint32_t spawnId = it.first;
 		const spawnBlock_t& sb = it.second;
-		spawnMonster(spawnId, sb, true);
+		if (spawnMonster(spawnId, sb, true)) {
+			++spawned;
+		} else {
+			++failed;
+		}
+	}
+
+	if (spawnedMap.size() < spawnMap.size()) {
+		startSpawnCheck();
 	}
 }
 
 void Spawn::checkSpawn()
 {
-	checkSpawnEvent = 0;
+	checkQueued = false;
 
 	cleanup();
 
-	uint32_t spawnCount = 0;
-
+	// every free block gets its own entry in the respawn queue, due when its spawn time has passed
+	const int64_t now = OTSYS_TIME();
 	for (auto& it : spawnMap) {
 		uint32_t spawnId = it.first;
-		if (spawnedMap.find(spawnId) != spawnedMap.end()) {
+		spawnBlock_t& sb = it.second;
+		if (sb.queued || spawnedMap.contains(spawnId)) {
 			continue;
 		}
 
-		spawnBlock_t& sb = it.second;
-		if (OTSYS_TIME() >= sb.lastSpawn + sb.interval) {
-			if (!spawnMonster(spawnId, sb)) {
-				sb.lastSpawn = OTSYS_TIME();
-				continue;
-			}
+		sb.queued = true;
+		g_game.map.spawns.scheduleCheck(*this, spawnId, std::max(now, sb.lastSpawn + sb.interval));
+	}
+}
 
-			if (++spawnCount >= getInteger(ConfigManager::RATE_SPAWN)) {
-				break;
-			}
-		}
+bool Spawn::checkBlock(uint32_t spawnId, uint32_t& spawnCount, SpawnStatistics& statistics)
+{
+	spawnBlock_t& sb = spawnMap[spawnId];
+	sb.queued = false;
+
+	if (spawnedMap.contains(spawnId)) {
+		return false;
 	}
 
-	if (spawnedMap.size() < spawnMap.size()) {
-		checkSpawnEvent = g_scheduler.addEvent(createSchedulerTask(getInterval(), [this]() { checkSpawn(); }));
+	const int64_t now = OTSYS_TIME();
+	if (spawnCount >= getInteger(ConfigManager::RATE_SPAWN)) {
+		sb.queued = true;
+		g_game.map.spawns.scheduleCheck(*this, spawnId, now + getInterval());
+		return false;
+	}
+
+	if (!spawnMonster(spawnId, sb)) {
+		++statistics.blocked;
+		sb.lastSpawn = now;
+		sb.queued = true;
+		g_game.map.spawns.scheduleCheck(*this, spawnId, now + sb.interval);
+		return false;
 	}
+
+	++spawnCount;
+	++statistics.respawns;
+	return true;
 }
 
 void Spawn::cleanup()
@@ -439,11 +510,3 @@ void Spawn::removeMonster(Monster* monster)
 		}
 	}
 }
-
-void Spawn::stopEvent()
-{
-	if (checkSpawnEvent != 0) {
-		g_scheduler.stopEvent(checkSpawnEvent);
-		checkSpawnEvent = 0;
-	}
-}
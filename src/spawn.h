@@ -7,6 +7,7 @@
 #include "position.h"
 #include "tile.h"
 
+#include <queue>
 #include <utility>
 #include <vector>
 
@@ -21,6 +22,15 @@ struct spawnBlock_t
 	int64_t lastSpawn;
 	uint32_t interval;
 	Direction direction;
+	bool queued = false;
+};
+
+struct SpawnStatistics
+{
+	uint64_t respawns = 0;
+	uint64_t blocked = 0;
+	uint64_t checks = 0;
+	uint64_t checkTime = 0; // microseconds
 };
 
 class Spawn
@@ -38,10 +48,9 @@ public:
 	void removeMonster(Monster* monster);
 
 	uint32_t getInterval() const { return interval; }
-	void startup();
+	void startup(uint32_t& spawned, uint32_t& failed);
 
 	void startSpawnCheck();
-	void stopEvent();
 
 	bool isInSpawnZone(const Position& pos);
 	void cleanup();
@@ -58,12 +67,15 @@ private:
 	int32_t radius;
 
 	uint32_t interval = 60000;
-	uint32_t checkSpawnEvent = 0;
+	bool checkQueued = false;
 
 	static bool findPlayer(const Position& pos);
 	bool spawnMonster(uint32_t spawnId, spawnBlock_t sb, bool startup = false);
 	bool spawnMonster(uint32_t spawnId, MonsterType* mType, const Position& pos, Direction dir, bool startup = false);
 	void checkSpawn();
+	bool checkBlock(uint32_t spawnId, uint32_t& spawnCount, SpawnStatistics& statistics);
+
+	friend class Spawns;
 };
 
 class Spawns
@@ -77,7 +89,29 @@ public:
 
 	bool isStarted() const { return started; }
 
+	// spawnId 0 runs a full check of the spawn, any other id respawns that block
+	void scheduleCheck(Spawn& spawn, uint32_t spawnId, int64_t dueTime);
+
+	const SpawnStatistics& getStatistics() const { return statistics; }
+
 private:
+	struct SpawnCheck
+	{
+		int64_t dueTime;
+		Spawn* spawn;
+		uint32_t spawnId;
+
+		bool operator>(const SpawnCheck& other) const { return dueTime > other.dueTime; }
+	};
+
+	void checkSpawns();
+
+	std::priority_queue<SpawnCheck, std::vector<SpawnCheck>, std::greater<>> checkQueue;
+	SpawnStatistics statistics;
+	int64_t checkEventTime = 0;
+	uint32_t checkEvent = 0;
+	bool checking = false;
+
 	std::forward_list<Npc*> npcList;
 	std::forward_list<Spawn> spawnList;
 	std::string filename;
@@ -94,6 +94,11 @@ void Spells::clearMaps(bool fromLua)
 			++rune;
 		}
 	}
+
+	instantWords.clear();
+	for (auto& it : instants) {
+		instantWords.insert(it.first, &it.second);
+	}
 }
 
 void Spells::clear(bool fromLua)
@@ -125,8 +130,11 @@ bool Spells::registerEvent(Event_ptr event, const pugi::xml_node&)
 		if (!result.second) {
 			std::cout << "[Warning - Spells::registerEvent] Duplicate registered instant spell with words: "
 			          << instant->getWords() << std::endl;
+			return false;
 		}
-		return result.second;
+
+		instantWords.insert(result.first->first, &result.first->second);
+		return true;
 	}
 
 	RuneSpell* rune = dynamic_cast<RuneSpell*>(event.get());
@@ -151,8 +159,11 @@ bool Spells::registerInstantLuaEvent(InstantSpell* event)
 		if (!result.second) {
 			std::cout << "[Warning - Spells::registerInstantLuaEvent] Duplicate registered instant spell with words: "
 			          << words << std::endl;
+			return false;
 		}
-		return result.second;
+
+		instantWords.insert(result.first->first, &result.first->second);
+		return true;
 	}
 
 	return false;
@@ -209,21 +220,7 @@ RuneSpell* Spells::getRuneSpellByName(std::string_view name)
 
 InstantSpell* Spells::getInstantSpell(std::string_view words)
 {
-	InstantSpell* result = nullptr;
-
-	for (auto& it : instants) {
-		auto instantSpellWords = it.second.getWords();
-		size_t spellLen = instantSpellWords.length();
-		if (caseInsensitiveStartsWith(words, instantSpellWords)) {
-			if (!result || spellLen > result->getWords().size()) {
-				result = &it.second;
-				if (words.length() == spellLen) {
-					break;
-				}
-			}
-		}
-	}
-
+	InstantSpell* result = instantWords.findLongestPrefix(words);
 	if (result) {
 		auto resultWords = result->getWords();
 		if (words.length() > resultWords.length()) {
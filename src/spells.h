@@ -9,6 +9,7 @@
 #include "player.h"
 #include "talkaction.h"
 #include "vocation.h"
+#include "wordtrie.h"
 
 class InstantSpell;
 class RuneSpell;
@@ -55,6 +56,7 @@ private:
 
 	std::map<uint16_t, RuneSpell> runes;
 	std::map<std::string, InstantSpell> instants;
+	WordTrie<InstantSpell> instantWords;
 
 	friend class CombatSpell;
 	LuaScriptInterface scriptInterface{"Spell Interface"};
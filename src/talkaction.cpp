@@ -22,6 +22,11 @@ void TalkActions::clear(bool fromLua)
 		}
 	}
 
+	talkActionWords.clear();
+	for (const auto& it : talkActions) {
+		talkActionWords.insert(it.first, &it.second);
+	}
+
 	reInitState(fromLua);
 }
 
@@ -41,7 +46,8 @@ bool TalkActions::registerEvent(Event_ptr event, const pugi::xml_node&)
 	const auto& words = talkAction->stealWordsMap();
 
 	for (const auto& word : words) {
-		talkActions.emplace(word, *talkAction);
+		auto it = talkActions.emplace(word, *talkAction).first;
+		talkActionWords.insert(it->first, &it->second);
 	}
 	return true;
 }
@@ -57,36 +63,29 @@ bool TalkActions::registerLuaEvent(TalkAction* event)
 	}
 
 	for (const auto& word : words) {
-		talkActions.emplace(word, *talkAction);
+		auto it = talkActions.emplace(word, *talkAction).first;
+		talkActionWords.insert(it->first, &it->second);
 	}
 	return true;
 }
 
 TalkActionResult TalkActions::playerSaySpell(Player* player, SpeakClasses type, std::string_view words) const
 {
-	size_t wordsLength = words.length();
-	for (auto it = talkActions.begin(); it != talkActions.end();) {
-		std::string_view talkactionWords = it->first;
-		if (!caseInsensitiveStartsWith(words, talkactionWords)) {
-			++it;
-			continue;
-		}
-
+	TalkActionResult result = TalkActionResult::CONTINUE;
+	talkActionWords.forEachPrefix(words, [&](size_t talkactionLength, const TalkAction* talkAction) {
 		std::string param;
-		if (wordsLength != talkactionWords.size()) {
-			param = words.substr(talkactionWords.size());
+		if (words.length() != talkactionLength) {
+			param = words.substr(talkactionLength);
 			if (param.front() != ' ') {
-				++it;
-				continue;
+				return false;
 			}
 			boost::algorithm::trim_left(param);
 
-			auto separator = it->second.getSeparator();
+			auto separator = talkAction->getSeparator();
 			if (separator != " ") {
 				if (!param.empty()) {
 					if (param != separator) {
-						++it;
-						continue;
+						return false;
 					} else {
 						param.erase(param.begin());
 					}
@@ -94,21 +93,20 @@ TalkActionResult TalkActions::playerSaySpell(Player* player, SpeakClasses type,
 			}
 		}
 
-		if (it->second.getNeedAccess() && !player->isAccessPlayer()) {
-			return TalkActionResult::CONTINUE;
+		if (talkAction->getNeedAccess() && !player->isAccessPlayer()) {
+			return true;
 		}
 
-		if (player->getAccountType() < it->second.getRequiredAccountType()) {
-			return TalkActionResult::CONTINUE;
+		if (player->getAccountType() < talkAction->getRequiredAccountType()) {
+			return true;
 		}
 
-		if (it->second.executeSay(player, words, param, type)) {
-			return TalkActionResult::CONTINUE;
-		} else {
-			return TalkActionResult::BREAK;
+		if (!talkAction->executeSay(player, words, param, type)) {
+			result = TalkActionResult::BREAK;
 		}
-	}
-	return TalkActionResult::CONTINUE;
+		return true;
+	});
+	return result;
 }
 
 bool TalkAction::configureEvent(const pugi::xml_node& node)
@@ -7,6 +7,7 @@
 #include "baseevents.h"
 #include "const.h"
 #include "luascript.h"
+#include "wordtrie.h"
 
 class TalkAction;
 using TalkAction_ptr = std::unique_ptr<TalkAction>;
@@ -85,6 +86,7 @@ private:
 	bool registerEvent(Event_ptr event, const pugi::xml_node& node) override;
 
 	std::map<std::string, TalkAction> talkActions;
+	WordTrie<const TalkAction> talkActionWords;
 
 	LuaScriptInterface scriptInterface;
 };
@@ -7,6 +7,7 @@
 
 #include "enums.h"
 #include "game.h"
+#include "outputmessage.h"
 
 extern Game g_game;
 
@@ -39,6 +40,9 @@ void Dispatcher::threadMain()
 			delete task;
 		}
 		tmpTaskList.clear();
+
+		// everything the batch wrote to clients goes out now instead of waiting for a timer
+		OutputMessagePool::getInstance().sendAll();
 	}
 }
 
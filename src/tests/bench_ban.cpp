@@ -0,0 +1,46 @@
+// Throughput of the connection throttle under a flood from a few addresses mixed with single connections from many
+// others, decided on several threads at once. Not part of ctest, run it by hand.
+
+#include "../otpch.h"
+
+#include "../ban.h"
+
+int main()
+{
+	Ban ban;
+
+	constexpr uint32_t threadCount = 4;
+	constexpr uint32_t attemptsPerThread = 200000;
+	constexpr uint32_t floodingAddresses = 64;
+
+	std::atomic<uint64_t> accepted = 0, rejected = 0;
+	std::vector<std::thread> threads;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t]() {
+			uint64_t threadAccepted = 0, threadRejected = 0;
+			for (uint32_t i = 0; i < attemptsPerThread; ++i) {
+				uint32_t ip = i % 2 == 0 ? 0x0B000000 + (i / 2) % floodingAddresses
+				                         : 0x0C000000 + t * attemptsPerThread + i;
+				if (ban.acceptConnection(ip)) {
+					++threadAccepted;
+				} else {
+					++threadRejected;
+				}
+			}
+			accepted += threadAccepted;
+			rejected += threadRejected;
+		});
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << "decided " << threadCount * attemptsPerThread << " connections in " << elapsed.count() << " s, "
+	          << static_cast<uint64_t>(accepted / elapsed.count()) << " accepted/s, "
+	          << static_cast<uint64_t>(rejected / elapsed.count()) << " rejected/s" << std::endl;
+	return 0;
+}
@@ -0,0 +1,38 @@
+// Throughput of status requests answered by one thread from a snapshot. Not part of ctest, run it by hand.
+
+#include "../otpch.h"
+
+#include "../protocolstatus.h"
+
+int main()
+{
+	StatusInfo info;
+	info.uptime = 3600;
+	info.playersOnline = 500;
+	info.playersRecord = 1000;
+	for (uint32_t i = 0; i < info.playersOnline; ++i) {
+		info.players.emplace_back("Player " + std::to_string(i), 100 + i);
+	}
+	StatusSnapshot snapshot{info, 0};
+
+	constexpr int requests = 100000;
+	NetworkMessage msg;
+	size_t bytes = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < requests; ++i) {
+		msg.reset();
+		if (i % 2 == 0) {
+			std::string_view status = snapshot.getStatusString();
+			msg.addBytes(status.data(), status.size());
+		} else {
+			snapshot.writeInfo(msg, 0xFF, "Player 250");
+		}
+		bytes += msg.getLength();
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << "served " << requests << " status requests (" << bytes << " bytes) in " << elapsed.count() << " s, "
+	          << static_cast<uint64_t>(requests / elapsed.count()) << " requests/s" << std::endl;
+	return 0;
+}
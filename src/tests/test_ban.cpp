@@ -0,0 +1,65 @@
+#define BOOST_TEST_MODULE ban
+
+#include "../otpch.h"
+
+#include "../ban.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(test_Ban_acceptConnection)
+{
+	Ban ban;
+	constexpr uint32_t ip = 0x0A000001;
+
+	// six attempts in a row block the address, other addresses are unaffected
+	for (int i = 0; i < 5; ++i) {
+		BOOST_TEST(ban.acceptConnection(ip));
+	}
+	BOOST_TEST(!ban.acceptConnection(ip));
+	BOOST_TEST(!ban.acceptConnection(ip));
+	BOOST_TEST(ban.acceptConnection(ip + 1));
+	BOOST_TEST(ban.getTrackedCount() == 2u);
+}
+
+// a flood of connections from a few abusive addresses mixed with single connections from many others, accepted from
+// several threads at once
+BOOST_AUTO_TEST_CASE(test_Ban_flood)
+{
+	Ban ban;
+
+	constexpr uint32_t threadCount = 4;
+	constexpr uint32_t attemptsPerThread = 2000;
+	constexpr uint32_t floodingAddresses = 64;
+
+	std::atomic<uint64_t> accepted = 0, rejected = 0, uniqueAccepted = 0;
+	std::vector<std::thread> threads;
+
+	for (uint32_t t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t]() {
+			uint64_t threadAccepted = 0, threadRejected = 0, threadUniqueAccepted = 0;
+			for (uint32_t i = 0; i < attemptsPerThread; ++i) {
+				if (i % 2 == 0) {
+					if (ban.acceptConnection(0x0B000000 + (i / 2) % floodingAddresses)) {
+						++threadAccepted;
+					} else {
+						++threadRejected;
+					}
+				} else if (ban.acceptConnection(0x0C000000 + t * attemptsPerThread + i)) {
+					++threadUniqueAccepted;
+				}
+			}
+			accepted += threadAccepted;
+			rejected += threadRejected;
+			uniqueAccepted += threadUniqueAccepted;
+		});
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	// addresses seen once are never throttled, the flooding ones are held to a handful of connections each
+	BOOST_TEST(uniqueAccepted == threadCount * attemptsPerThread / 2);
+	BOOST_TEST(accepted < uint64_t{floodingAddresses} * 10);
+	BOOST_TEST(accepted + rejected == threadCount * attemptsPerThread / 2);
+}
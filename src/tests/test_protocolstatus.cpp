@@ -0,0 +1,91 @@
+#define BOOST_TEST_MODULE protocolstatus
+
+#include "../otpch.h"
+
+#include "../protocolstatus.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+StatusInfo makeStatusInfo(uint32_t playerCount)
+{
+	StatusInfo info;
+	info.uptime = 3600;
+	info.playersOnline = playerCount;
+	info.playersRecord = playerCount * 2;
+	info.monstersOnline = 20000;
+	info.npcsOnline = 300;
+	info.mapWidth = 2048;
+	info.mapHeight = 2048;
+	for (uint32_t i = 0; i < playerCount; ++i) {
+		info.players.emplace_back("Player " + std::to_string(i), 100 + i);
+	}
+	return info;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_StatusSnapshot_statusString)
+{
+	StatusSnapshot snapshot{makeStatusInfo(5), 0};
+
+	std::string_view status = snapshot.getStatusString();
+	BOOST_TEST(status.starts_with("<?xml"));
+	BOOST_TEST(status.find("uptime=\"3600\"") != std::string_view::npos);
+	BOOST_TEST(status.find("online=\"5\"") != std::string_view::npos);
+	BOOST_TEST(status.find("peak=\"10\"") != std::string_view::npos);
+	BOOST_TEST(status.find("width=\"2048\"") != std::string_view::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_StatusSnapshot_writeInfo)
+{
+	StatusSnapshot snapshot{makeStatusInfo(3), 0};
+
+	// players info, online players list and online status of a player, in that order
+	NetworkMessage msg;
+	snapshot.writeInfo(msg, (1 << 3) | (1 << 5) | (1 << 6), "PLAYER 1");
+	msg.setBufferPosition(0);
+
+	BOOST_TEST(msg.getByte() == 0x20);
+	BOOST_TEST(msg.get<uint32_t>() == 3u);
+	msg.get<uint32_t>();
+	BOOST_TEST(msg.get<uint32_t>() == 6u);
+
+	BOOST_TEST(msg.getByte() == 0x21);
+	BOOST_TEST(msg.get<uint32_t>() == 3u);
+	for (uint32_t i = 0; i < 3; ++i) {
+		BOOST_TEST(msg.getString() == "Player " + std::to_string(i));
+		BOOST_TEST(msg.get<uint32_t>() == 100 + i);
+	}
+
+	BOOST_TEST(msg.getByte() == 0x22);
+	BOOST_TEST(msg.getByte() == 0x01);
+	BOOST_TEST(msg.getBufferPosition() == msg.getLength() + NetworkMessage::INITIAL_BUFFER_POSITION);
+	BOOST_TEST(!msg.isOverrun());
+
+	NetworkMessage offline;
+	snapshot.writeInfo(offline, 1 << 6, "Player 3");
+	offline.setBufferPosition(0);
+	BOOST_TEST(offline.getByte() == 0x22);
+	BOOST_TEST(offline.getByte() == 0x00);
+}
+
+BOOST_AUTO_TEST_CASE(test_StatusSnapshot_repeatedRequests)
+{
+	StatusSnapshot snapshot{makeStatusInfo(500), 0};
+
+	// the snapshot is rendered once, every request gets the same bytes
+	NetworkMessage first;
+	snapshot.writeInfo(first, 0xFF, "Player 250");
+
+	NetworkMessage msg;
+	for (int i = 0; i < 100; ++i) {
+		msg.reset();
+		snapshot.writeInfo(msg, 0xFF, "Player 250");
+		BOOST_TEST(msg.getLength() == first.getLength());
+		BOOST_TEST(std::equal(msg.getBuffer(), msg.getBuffer() + msg.getLength() + NetworkMessage::INITIAL_BUFFER_POSITION,
+		                      first.getBuffer()));
+	}
+	BOOST_TEST(snapshot.getStatusString().data() == snapshot.getStatusString().data());
+}
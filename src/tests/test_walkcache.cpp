@@ -0,0 +1,78 @@
+#define BOOST_TEST_MODULE walkcache
+
+#include "../otpch.h"
+
+#include "../creature.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(test_WalkCache_set)
+{
+	WalkCache cache;
+	BOOST_TEST(!cache.test(0, 0));
+
+	cache.set(0, 0, true);
+	cache.set(-WalkCache::maxOffsetX, -WalkCache::maxOffsetY, true);
+	cache.set(WalkCache::maxOffsetX, WalkCache::maxOffsetY, true);
+	BOOST_TEST(cache.test(0, 0));
+	BOOST_TEST(cache.test(-WalkCache::maxOffsetX, -WalkCache::maxOffsetY));
+	BOOST_TEST(cache.test(WalkCache::maxOffsetX, WalkCache::maxOffsetY));
+	BOOST_TEST(!cache.test(1, 0));
+
+	cache.set(0, 0, false);
+	BOOST_TEST(!cache.test(0, 0));
+
+	cache.clear();
+	BOOST_TEST(!cache.test(WalkCache::maxOffsetX, WalkCache::maxOffsetY));
+}
+
+BOOST_AUTO_TEST_CASE(test_WalkCache_shift)
+{
+	constexpr int32_t maxX = WalkCache::maxOffsetX;
+	constexpr int32_t maxY = WalkCache::maxOffsetY;
+
+	// one step east, the tile east of us becomes the tile we stand on
+	WalkCache cache;
+	cache.set(1, 0, true);
+	cache.set(-maxX, 0, true);
+	cache.shift(1, 0);
+	BOOST_TEST(cache.test(0, 0));
+	BOOST_TEST(!cache.test(1, 0));
+	BOOST_TEST(!cache.test(-maxX, 0));
+	BOOST_TEST(!cache.test(maxX, 0));
+
+	// one step west
+	cache.clear();
+	cache.set(-1, 2, true);
+	cache.set(maxX, 2, true);
+	cache.shift(-1, 0);
+	BOOST_TEST(cache.test(0, 2));
+	BOOST_TEST(!cache.test(-1, 2));
+	BOOST_TEST(!cache.test(maxX, 2));
+	BOOST_TEST(!cache.test(-maxX, 2));
+
+	// one step north
+	cache.clear();
+	cache.set(3, -1, true);
+	cache.set(3, maxY, true);
+	cache.shift(0, -1);
+	BOOST_TEST(cache.test(3, 0));
+	BOOST_TEST(!cache.test(3, maxY));
+	BOOST_TEST(!cache.test(3, -maxY));
+
+	// one step south
+	cache.clear();
+	cache.set(-3, 1, true);
+	cache.set(-3, -maxY, true);
+	cache.shift(0, 1);
+	BOOST_TEST(cache.test(-3, 0));
+	BOOST_TEST(!cache.test(-3, -maxY));
+	BOOST_TEST(!cache.test(-3, maxY));
+
+	// diagonal step north-east
+	cache.clear();
+	cache.set(1, -1, true);
+	cache.shift(1, -1);
+	BOOST_TEST(cache.test(0, 0));
+	BOOST_TEST(!cache.test(1, -1));
+}
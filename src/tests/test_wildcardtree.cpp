@@ -0,0 +1,44 @@
+#define BOOST_TEST_MODULE wildcardtree
+
+#include "../otpch.h"
+
+#include "../wildcardtree.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(test_WildcardTree_findOne)
+{
+	WildcardTreeNode tree{false};
+	tree.insert("alice");
+	tree.insert("albert");
+	tree.insert("bob");
+
+	std::string result;
+	BOOST_TEST(tree.findOne("b", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "bob");
+
+	BOOST_TEST(tree.findOne("ali", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "alice");
+
+	BOOST_TEST(tree.findOne("al", result) == RETURNVALUE_NAMEISTOOAMBIGUOUS);
+	BOOST_TEST(tree.findOne("carl", result) == RETURNVALUE_PLAYERWITHTHISNAMEISNOTONLINE);
+}
+
+BOOST_AUTO_TEST_CASE(test_WildcardTree_remove)
+{
+	WildcardTreeNode tree{false};
+	tree.insert("alice");
+	tree.insert("albert");
+	tree.insert("al");
+
+	std::string result;
+	BOOST_TEST(tree.findOne("al", result) == RETURNVALUE_NAMEISTOOAMBIGUOUS);
+
+	tree.remove("albert");
+	BOOST_TEST(tree.findOne("alb", result) == RETURNVALUE_PLAYERWITHTHISNAMEISNOTONLINE);
+	BOOST_TEST(tree.findOne("al", result) == RETURNVALUE_NAMEISTOOAMBIGUOUS);
+
+	tree.remove("al");
+	BOOST_TEST(tree.findOne("al", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "alice");
+}
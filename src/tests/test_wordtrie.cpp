@@ -0,0 +1,45 @@
+#define BOOST_TEST_MODULE wordtrie
+
+#include "../otpch.h"
+
+#include "../wordtrie.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(test_WordTrie_longestPrefix)
+{
+	int light = 1, greatLight = 2, heal = 3;
+
+	WordTrie<int> trie;
+	BOOST_TEST(trie.insert("utevo lux", &light));
+	BOOST_TEST(trie.insert("utevo gran lux", &greatLight));
+	BOOST_TEST(trie.insert("exura", &heal));
+	BOOST_TEST(!trie.insert("EXURA", &light));
+
+	BOOST_TEST(trie.findLongestPrefix("utevo lux") == &light);
+	BOOST_TEST(trie.findLongestPrefix("UTEVO GRAN LUX") == &greatLight);
+	BOOST_TEST(trie.findLongestPrefix("exura \"friend") == &heal);
+	BOOST_TEST(trie.findLongestPrefix("utevo") == nullptr);
+	BOOST_TEST(trie.findLongestPrefix("") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_WordTrie_forEachPrefix)
+{
+	int a = 1, ab = 2;
+
+	WordTrie<int> trie;
+	trie.insert("/a", &a);
+	trie.insert("/ab", &ab);
+
+	std::vector<size_t> lengths;
+	trie.forEachPrefix("/ab x", [&lengths](size_t length, int*) {
+		lengths.push_back(length);
+		return false;
+	});
+	BOOST_TEST(lengths == (std::vector<size_t>{2, 3}), boost::test_tools::per_element());
+
+	BOOST_TEST(trie.forEachPrefix("/ab x", [](size_t, int*) { return true; }) == &a);
+
+	trie.clear();
+	BOOST_TEST(trie.findLongestPrefix("/ab") == nullptr);
+}
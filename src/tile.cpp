@@ -21,6 +21,25 @@ extern MoveEvents* g_moveEvents;
 StaticTile real_nullptr_tile(0xFFFF, 0xFFFF, 0xFF);
 Tile& Tile::nullptr_tile = real_nullptr_tile;
 
+namespace {
+
+// tiles mostly live as long as the map, the pool mainly serves tiles created and dropped by house and map reloads
+constexpr size_t TILE_POOL_CAPACITY = 1024;
+
+LockfreeObjectPool<TILE_POOL_CAPACITY>& getTilePool()
+{
+	static auto* pool = new LockfreeObjectPool<TILE_POOL_CAPACITY>();
+	return *pool;
+}
+
+} // namespace
+
+void* Tile::operator new(size_t size) { return getTilePool().allocate(size); }
+
+void Tile::operator delete(void* p, size_t size) { getTilePool().deallocate(p, size); }
+
+PoolStatistics Tile::getPoolStatistics() { return getTilePool().getStatistics(); }
+
 bool Tile::hasProperty(ITEMPROPERTY prop) const
 {
 	if (ground && ground->hasProperty(prop)) {
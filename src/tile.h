@@ -127,6 +127,10 @@ public:
 	Tile(const Tile&) = delete;
 	Tile& operator=(const Tile&) = delete;
 
+	static void* operator new(size_t size);
+	static void operator delete(void* p, size_t size);
+	static PoolStatistics getPoolStatistics();
+
 	virtual TileItemVector* getItemList() = 0;
 	virtual const TileItemVector* getItemList() const = 0;
 	virtual TileItemVector* makeItemList() = 0;
@@ -172,6 +176,10 @@ public:
 	bool hasProperty(const Item* exclude, ITEMPROPERTY prop) const;
 
 	bool hasFlag(uint32_t flag) const { return hasBitSet(flag, this->flags); }
+	bool isPathBlocking() const
+	{
+		return !ground || hasFlag(TILESTATE_FLOORCHANGE | TILESTATE_TELEPORT | TILESTATE_IMMOVABLEBLOCKSOLID);
+	}
 	void setFlag(uint32_t flag) { this->flags |= flag; }
 	void resetFlag(uint32_t flag) { this->flags &= ~flag; }
 
@@ -7,10 +7,21 @@
 
 #include <stack>
 
+namespace {
+
+template <typename Children>
+auto findChild(Children& children, char ch)
+{
+	return std::lower_bound(children.begin(), children.end(), ch,
+	                        [](const auto& child, char c) { return child.first < c; });
+}
+
+} // namespace
+
 WildcardTreeNode* WildcardTreeNode::getChild(char ch)
 {
-	auto it = children.find(ch);
-	if (it == children.end()) {
+	auto it = findChild(children, ch);
+	if (it == children.end() || it->first != ch) {
 		return nullptr;
 	}
 	return &it->second;
@@ -18,8 +29,8 @@ WildcardTreeNode* WildcardTreeNode::getChild(char ch)
 
 const WildcardTreeNode* WildcardTreeNode::getChild(char ch) const
 {
-	auto it = children.find(ch);
-	if (it == children.end()) {
+	auto it = findChild(children, ch);
+	if (it == children.end() || it->first != ch) {
 		return nullptr;
 	}
 	return &it->second;
@@ -27,17 +38,16 @@ const WildcardTreeNode* WildcardTreeNode::getChild(char ch) const
 
 WildcardTreeNode* WildcardTreeNode::addChild(char ch, bool breakpoint)
 {
-	WildcardTreeNode* child = getChild(ch);
-	if (child) {
-		if (breakpoint && !child->breakpoint) {
-			child->breakpoint = true;
+	auto it = findChild(children, ch);
+	if (it != children.end() && it->first == ch) {
+		if (breakpoint && !it->second.breakpoint) {
+			it->second.breakpoint = true;
 		}
 	} else {
-		auto pair =
-		    children.emplace(std::piecewise_construct, std::forward_as_tuple(ch), std::forward_as_tuple(breakpoint));
-		child = &pair.first->second;
+		it = children.emplace(it, std::piecewise_construct, std::forward_as_tuple(ch),
+		                      std::forward_as_tuple(breakpoint));
 	}
-	return child;
+	return &it->second;
 }
 
 void WildcardTreeNode::insert(std::string_view str)
@@ -79,8 +89,8 @@ void WildcardTreeNode::remove(std::string_view str)
 
 		cur = path.top();
 
-		auto it = cur->children.find(str[--len]);
-		if (it != cur->children.end()) {
+		auto it = findChild(cur->children, str[--len]);
+		if (it != cur->children.end() && it->first == str[len]) {
 			cur->children.erase(it);
 		}
 	} while (true);
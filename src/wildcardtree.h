@@ -11,6 +11,7 @@ class WildcardTreeNode
 public:
 	explicit WildcardTreeNode(bool breakpoint) : breakpoint(breakpoint) {}
 	WildcardTreeNode(WildcardTreeNode&& other) = default;
+	WildcardTreeNode& operator=(WildcardTreeNode&& other) = default;
 
 	// non-copyable
 	WildcardTreeNode(const WildcardTreeNode&) = delete;
@@ -26,7 +27,8 @@ public:
 	ReturnValue findOne(std::string_view query, std::string& result) const;
 
 private:
-	std::map<char, WildcardTreeNode> children;
+	// sorted by character and stored contiguously, names only branch a few ways per node
+	std::vector<std::pair<char, WildcardTreeNode>> children;
 	bool breakpoint;
 };
 
@@ -0,0 +1,111 @@
+// Copyright 2023 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_WORDTRIE_H
+#define FS_WORDTRIE_H
+
+// Case-folded prefix trie mapping spoken words to the spell or talkaction registered for them. Lookups walk the
+// said text once instead of comparing it against every registered entry.
+template <typename T>
+class WordTrie
+{
+public:
+	WordTrie() { clear(); }
+
+	// keeps the value that was inserted first when two words fold to the same key
+	bool insert(std::string_view words, T* value)
+	{
+		uint32_t index = 0;
+		for (char ch : words) {
+			index = getOrAddChild(index, fold(ch));
+		}
+
+		Node& node = nodes[index];
+		if (node.value) {
+			return false;
+		}
+
+		node.value = value;
+		return true;
+	}
+
+	void clear()
+	{
+		nodes.clear();
+		nodes.emplace_back();
+	}
+
+	// the value whose words are the longest prefix of text, if any
+	T* findLongestPrefix(std::string_view text) const
+	{
+		T* result = nullptr;
+		forEachPrefix(text, [&result](size_t, T* value) {
+			result = value;
+			return false;
+		});
+		return result;
+	}
+
+	// calls visitor(wordsLength, value) for every value whose words prefix text, shortest first, until it returns true
+	template <typename Visitor>
+	T* forEachPrefix(std::string_view text, Visitor&& visitor) const
+	{
+		uint32_t index = 0;
+		for (size_t length = 0; length <= text.size(); ++length) {
+			if (length != 0) {
+				index = getChild(index, fold(text[length - 1]));
+				if (index == 0) {
+					break;
+				}
+			}
+
+			T* value = nodes[index].value;
+			if (value && visitor(length, value)) {
+				return value;
+			}
+		}
+		return nullptr;
+	}
+
+private:
+	struct Node
+	{
+		// sorted by character; index 0 is the root, so it doubles as "no child"
+		std::vector<std::pair<char, uint32_t>> children;
+		T* value = nullptr;
+	};
+
+	static char fold(char ch) { return static_cast<char>(tolower(static_cast<unsigned char>(ch))); }
+
+	uint32_t getChild(uint32_t index, char ch) const
+	{
+		const auto& children = nodes[index].children;
+		auto it = std::lower_bound(children.begin(), children.end(), ch,
+		                           [](const auto& entry, char c) { return entry.first < c; });
+		if (it == children.end() || it->first != ch) {
+			return 0;
+		}
+		return it->second;
+	}
+
+	uint32_t getOrAddChild(uint32_t index, char ch)
+	{
+		uint32_t child = getChild(index, ch);
+		if (child != 0) {
+			return child;
+		}
+
+		child = static_cast<uint32_t>(nodes.size());
+		nodes.emplace_back();
+
+		auto& children = nodes[index].children;
+		auto it = std::lower_bound(children.begin(), children.end(), ch,
+		                           [](const auto& entry, char c) { return entry.first < c; });
+		children.emplace(it, ch, child);
+		return child;
+	}
+
+	std::vector<Node> nodes;
+};
+
+#endif